@@ -0,0 +1,143 @@
+// autopilot.h
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "gameLogic.h"
+#include <string>
+
+// ============================================================================
+// AUTOPILOT INTERFACE
+// ============================================================================
+
+/**
+ * @brief Pluggable input policy that steers a game instead of the keyboard.
+ *
+ * Called on the game thread between update() calls; reads the engine
+ * directly through the game-thread accessors and returns the direction to
+ * feed into SnakeGameLogic::setDirection().
+ */
+class Autopilot {
+public:
+    virtual ~Autopilot() = default;
+
+    /**
+     * @brief Chooses the next move.
+     * @param game Game to steer, between two update() calls
+     * @return Direction to pass to setDirection()
+     */
+    virtual Direction decide(const SnakeGameLogic& game) = 0;
+
+    /**
+     * @brief Called when a new game starts, to drop per-game state.
+     */
+    virtual void reset() {}
+
+    /**
+     * @brief Restarts the policy's own randomness, so a reused policy plays
+     *        a game the same way whichever games it played before.
+     * @param seed New seed; ignored by deterministic policies
+     */
+    virtual void reseed(uint64_t) {}
+
+    virtual string getName() const = 0;
+};
+
+// ============================================================================
+// BASIC AUTOPILOTS
+// ============================================================================
+
+/**
+ * @brief Shared move helpers for autopilots.
+ */
+class MoveHelper {
+public:
+    static constexpr int rowDelta[4] = {-1, 1, 0, 0};
+    static constexpr int colDelta[4] = {0, 0, -1, 1};
+
+    /**
+     * @brief Gets the direction opposite to another.
+     * @param dir Direction
+     * @return Reversed direction, or NONE for NONE
+     */
+    static Direction opposite(Direction dir) {
+        switch (dir) {
+            case UP:    return DOWN;
+            case DOWN:  return UP;
+            case LEFT:  return RIGHT;
+            case RIGHT: return LEFT;
+            case NONE:  break;
+        }
+        return NONE;
+    }
+
+    /**
+     * @brief Checks whether moving one step survives the next tick.
+     * @param game Game to inspect
+     * @param dir Direction to test
+     * @return True if the target cell is in bounds, not a wall and not body
+     */
+    static bool isSafe(const SnakeGameLogic& game, Direction dir) {
+        if (dir == opposite(game.getCurrentDirection())) return false;
+        pair<int, int> head = game.getSnake().getHead();
+        pair<int, int> target = {head.first + rowDelta[dir], head.second + colDelta[dir]};
+        const Board& board = game.getBoard();
+        return !CollisionDetector::isOutOfBounds(target, board) &&
+               !CollisionDetector::isWall(target, board) &&
+               !game.getSnake().checkSelfCollision(target, board);
+    }
+};
+
+/**
+ * @brief Picks a uniformly random move among the ones that survive a tick.
+ */
+class RandomAutopilot : public Autopilot {
+private:
+    Xoshiro256 rng;
+
+public:
+    explicit RandomAutopilot(uint64_t seed) : rng(seed) {}
+
+    Direction decide(const SnakeGameLogic& game) override {
+        Direction safe[4];
+        int safeCount = 0;
+        for (int d = 0; d < 4; d++) {
+            if (MoveHelper::isSafe(game, static_cast<Direction>(d))) {
+                safe[safeCount++] = static_cast<Direction>(d);
+            }
+        }
+        if (safeCount == 0) return game.getCurrentDirection();
+        return safe[rng.nextBounded(safeCount)];
+    }
+
+    void reseed(uint64_t seed) override { rng.seed(seed); }
+
+    string getName() const override { return "random"; }
+};
+
+/**
+ * @brief Moves towards the food along the Manhattan distance when safe.
+ */
+class GreedyAutopilot : public Autopilot {
+public:
+    Direction decide(const SnakeGameLogic& game) override {
+        pair<int, int> head = game.getSnake().getHead();
+        pair<int, int> food = game.getFoodManager().getPosition();
+
+        Direction best = game.getCurrentDirection();
+        int bestDistance = -1;
+        for (int d = 0; d < 4; d++) {
+            if (!MoveHelper::isSafe(game, static_cast<Direction>(d))) continue;
+            int distance = abs(food.first - head.first - MoveHelper::rowDelta[d]) +
+                           abs(food.second - head.second - MoveHelper::colDelta[d]);
+            if (bestDistance < 0 || distance < bestDistance) {
+                bestDistance = distance;
+                best = static_cast<Direction>(d);
+            }
+        }
+        return best;
+    }
+
+    string getName() const override { return "greedy"; }
+};
+
+#endif // AUTOPILOT_H
@@ -0,0 +1,383 @@
+// batchEngine.h
+#ifndef BATCHENGINE_H
+#define BATCHENGINE_H
+
+#include "gameLogic.h"
+#include "batchKernels.h"
+
+// ============================================================================
+// BATCH GAME ENGINE
+// ============================================================================
+
+/**
+ * @brief Steps many independent games at once in struct-of-arrays form.
+ *
+ * Every per-game scalar (head, direction, length, score, done flag, ...)
+ * lives in its own parallel array, and all boards, free-cell indices and
+ * body ring buffers live in one slab each, game i owning the slice
+ * [i * cellCount, (i + 1) * cellCount). All games share one board size.
+ *
+ * step() applies exactly the rules of SnakeGameLogic::update(), including
+ * the order in which the free-cell index is updated, so a game seeded the
+ * same way follows the same trajectory as a SnakeGameLogic. This holds
+ * while the starting body fits on the board behind the centered head; see
+ * reset().
+ * 
+ * A tick runs in two passes: a data-parallel head-advance pass over all
+ * games (see BatchKernels, dispatched to AVX2/SSE4.2 when available), then
+ * a per-game pass for the branchy part: tail check, growth, food respawn.
+ * Games only touch their own slices, so disjoint ranges can be stepped
+ * from different threads with stepRange().
+ *
+ * With auto-reset on, a game that ends is restarted in place during the
+ * same step; the finished episode's score and length stay readable until
+ * the next step.
+ */
+class BatchSnakeEngine {
+private:
+    int gameCount;
+    int rows;
+    int cols;
+    int cellCount;
+    int startingLength;
+    int pointsPerFood;
+    Direction initialDirection;
+
+    // Per-game state, one entry per game
+    vector<int32_t> headRow;
+    vector<int32_t> headCol;
+    vector<int32_t> directions;
+    vector<int32_t> lengths;
+    vector<int32_t> headSlots;      ///< Ring slot of the head in the body slab
+    vector<int32_t> growthPending;
+    vector<int32_t> scores;
+    vector<int32_t> done;
+    vector<int32_t> foodIndex;      ///< Flat food cell, or -1 when no food
+    vector<int32_t> freeCounts;
+    vector<Xoshiro256> rngs;
+
+    // Outcome of the last step, one entry per game
+    vector<uint8_t> foodEaten;
+    vector<uint8_t> episodeEnded;
+    vector<int32_t> episodeScores;  ///< Final score of an episode that ended
+    vector<int32_t> episodeLengths; ///< Final length of an episode that ended
+
+    // Auto-reset: episode k of game i uses stream k * gameCount + i
+    bool autoReset;
+    uint64_t autoResetSeed;
+    vector<uint64_t> episodeCounts;
+
+    // Head-advance pass outputs, one entry per game
+    vector<int32_t> newRow;
+    vector<int32_t> newCol;
+    vector<int32_t> newIndex;
+    vector<int32_t> newCell;
+    vector<int32_t> foodHit;
+    BatchKernels::KernelFunction advanceHeads;
+    KernelLevel kernelLevel;
+
+    // Slabs, cellCount entries per game
+    vector<uint8_t> cells;          ///< Padded by 3 bytes for 32-bit gathers
+    vector<int32_t> freeCells;
+    vector<int32_t> freeSlots;
+    vector<int32_t> bodies;         ///< Ring buffers of flat cell indices
+
+    void markOccupied(int game, int index) {
+        int32_t* freeList = &freeCells[static_cast<size_t>(game) * cellCount];
+        int32_t* slotOf = &freeSlots[static_cast<size_t>(game) * cellCount];
+        int slot = slotOf[index];
+        int last = freeList[--freeCounts[game]];
+        freeList[slot] = last;
+        slotOf[last] = slot;
+        slotOf[index] = -1;
+    }
+
+    void markFree(int game, int index) {
+        int32_t* freeList = &freeCells[static_cast<size_t>(game) * cellCount];
+        int32_t* slotOf = &freeSlots[static_cast<size_t>(game) * cellCount];
+        slotOf[index] = freeCounts[game];
+        freeList[freeCounts[game]++] = index;
+    }
+
+    /**
+     * @brief Mirrors Board::setCellType() for one game's board.
+     */
+    void setCell(int game, int index, uint8_t cellType) {
+        uint8_t& cell = cells[static_cast<size_t>(game) * cellCount + index];
+        if (cell == EMPTY && cellType != EMPTY) {
+            markOccupied(game, index);
+        } else if (cell != EMPTY && cellType == EMPTY) {
+            markFree(game, index);
+        }
+        cell = cellType;
+    }
+
+    int tailIndex(int game) const {
+        int slot = headSlots[game] + lengths[game] - 1;
+        if (slot >= cellCount) slot -= cellCount;
+        return bodies[static_cast<size_t>(game) * cellCount + slot];
+    }
+
+    /**
+     * @brief Mirrors FoodManager::placeRandom().
+     */
+    void placeFood(int game) {
+        if (freeCounts[game] == 0) {
+            foodIndex[game] = -1;
+            return;
+        }
+        uint32_t slot = rngs[game].nextBounded(freeCounts[game]);
+        int index = freeCells[static_cast<size_t>(game) * cellCount + slot];
+        setCell(game, index, FOOD);
+        foodIndex[game] = index;
+    }
+
+    /**
+     * @brief Finishes one game's tick after the head-advance pass.
+     * @param game Game index
+     */
+    void completeStep(int game) {
+        int cell = newCell[game];
+        int index = newIndex[game];
+        if (cell == WALL ||
+            (cell == SNAKE && (growthPending[game] > 0 || index != tailIndex(game)))) {
+            done[game] = 1;
+            return;
+        }
+
+        if (foodHit[game]) {
+            growthPending[game]++;
+            scores[game] += pointsPerFood;
+            setCell(game, index, EMPTY);
+            foodIndex[game] = -1;
+        }
+
+        if (growthPending[game] > 0) {
+            growthPending[game]--;
+            lengths[game]++;
+        } else {
+            setCell(game, tailIndex(game), EMPTY);
+        }
+        int slot = headSlots[game] == 0 ? cellCount - 1 : headSlots[game] - 1;
+        headSlots[game] = slot;
+        bodies[static_cast<size_t>(game) * cellCount + slot] = index;
+        setCell(game, index, SNAKE);
+        headRow[game] = newRow[game];
+        headCol[game] = newCol[game];
+
+        if (foodIndex[game] < 0) {
+            placeFood(game);
+        }
+
+        if (foodIndex[game] < 0 && growthPending[game] == 0) {
+            done[game] = 1;
+        }
+    }
+
+public:
+    /**
+     * @brief Allocates every array and slab for a batch of games.
+     * @param gameCount Number of games
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param startingLength Initial snake length
+     * @param pointsPerFood Points awarded per food
+     * @param initialDirection Starting movement direction
+     */
+    BatchSnakeEngine(int gameCount, int rows, int cols, int startingLength,
+                     int pointsPerFood, Direction initialDirection)
+        : gameCount(gameCount), rows(rows), cols(cols), cellCount(rows * cols),
+          startingLength(startingLength), pointsPerFood(pointsPerFood),
+          initialDirection(initialDirection),
+          headRow(gameCount), headCol(gameCount), directions(gameCount),
+          lengths(gameCount), headSlots(gameCount), growthPending(gameCount),
+          scores(gameCount), done(gameCount), foodIndex(gameCount),
+          freeCounts(gameCount), rngs(gameCount),
+          foodEaten(gameCount), episodeEnded(gameCount), episodeScores(gameCount),
+          episodeLengths(gameCount), autoReset(false), autoResetSeed(0),
+          episodeCounts(gameCount),
+          newRow(gameCount), newCol(gameCount), newIndex(gameCount),
+          newCell(gameCount), foodHit(gameCount) {
+        size_t slabSize = static_cast<size_t>(gameCount) * cellCount;
+        cells.resize(slabSize + 3);
+        freeCells.resize(slabSize);
+        freeSlots.resize(slabSize);
+        bodies.resize(slabSize);
+        setKernelLevel(BatchKernels::detectLevel());
+    }
+
+    /**
+     * @brief Chooses the head-advance kernel, e.g. to compare against scalar.
+     * @param level Requested level; clamped to what the CPU supports
+     */
+    void setKernelLevel(KernelLevel level) {
+        KernelLevel supported = BatchKernels::detectLevel();
+        kernelLevel = static_cast<int>(level) > static_cast<int>(supported) ? supported : level;
+        advanceHeads = BatchKernels::select(kernelLevel);
+    }
+
+    KernelLevel getKernelLevel() const { return kernelLevel; }
+
+    /**
+     * @brief Starts a new game in place, reusing its slab slices.
+     * @param game Game index
+     * @param seed Seed for the game's food placement
+     * @param stream Stream index; a SnakeGameLogic(seed, stream) places food identically
+     *               as long as the starting body fits on the board behind the
+     *               centered head (e.g. startingLength <= cols / 2 + 1 moving RIGHT)
+     */
+    void reset(int game, uint64_t seed, uint64_t stream = 0) {
+        rngs[game].seed(seed, stream);
+        size_t base = static_cast<size_t>(game) * cellCount;
+        fill(cells.begin() + base, cells.begin() + base + cellCount, EMPTY);
+        for (int i = 0; i < cellCount; i++) {
+            freeCells[base + i] = i;
+            freeSlots[base + i] = i;
+        }
+        freeCounts[game] = cellCount;
+
+        directions[game] = initialDirection;
+        growthPending[game] = 0;
+        scores[game] = 0;
+        done[game] = 0;
+        foodIndex[game] = -1;
+        headSlots[game] = 0;
+        lengths[game] = 0;
+
+        // Lay the body out behind the head as Snake::initialize does, but
+        // stop at the board edge: Snake::initialize keeps off-board segments
+        // in its body (they never touch a cell), which the flat-index ring
+        // here cannot hold, so such a game starts shorter than its
+        // SnakeGameLogic counterpart and the trajectories diverge
+        int r = rows / 2;
+        int c = cols / 2;
+        headRow[game] = r;
+        headCol[game] = c;
+        for (int i = 0; i < startingLength; i++) {
+            if (r < 0 || r >= rows || c < 0 || c >= cols) break;
+            int index = r * cols + c;
+            bodies[base + lengths[game]++] = index;
+            setCell(game, index, SNAKE);
+            switch (initialDirection) {
+                case RIGHT: c--; break;
+                case LEFT:  c++; break;
+                case UP:    r++; break;
+                case DOWN:  r--; break;
+                case NONE:  break;
+            }
+        }
+
+        placeFood(game);
+    }
+
+    /**
+     * @brief Starts every game, game i on stream i of the seed.
+     * @param seed Base seed
+     */
+    void resetAll(uint64_t seed) {
+        for (int game = 0; game < gameCount; game++) {
+            reset(game, seed, game);
+        }
+    }
+
+    /**
+     * @brief Restarts games in place as soon as they end.
+     *
+     * Episode k of game i uses stream k * getGameCount() + i of the seed,
+     * so the sequence of episodes does not depend on how steps are split
+     * across threads.
+     * @param enabled True to auto-reset
+     * @param seed Seed for the restarted episodes
+     */
+    void setAutoReset(bool enabled, uint64_t seed) {
+        autoReset = enabled;
+        autoResetSeed = seed;
+        fill(episodeCounts.begin(), episodeCounts.end(), 0);
+    }
+
+    /**
+     * @brief Advances every unfinished game by one tick.
+     * @param actions One direction per game; NONE keeps the current one
+     */
+    void step(const Direction* actions) {
+        stepRange(actions, 0, gameCount);
+    }
+
+    /**
+     * @brief Advances the unfinished games in [begin, end) by one tick.
+     * @param actions One direction per game, indexed by game
+     * @param begin First game
+     * @param end One past the last game
+     */
+    void stepRange(const Direction* actions, int begin, int end) {
+        HeadAdvanceArgs args;
+        args.rows = rows;
+        args.cols = cols;
+        args.cellCount = cellCount;
+        args.actions = reinterpret_cast<const int32_t*>(actions);
+        args.directions = directions.data();
+        args.headRow = headRow.data();
+        args.headCol = headCol.data();
+        args.foodIndex = foodIndex.data();
+        args.done = done.data();
+        args.cells = cells.data();
+        args.newRow = newRow.data();
+        args.newCol = newCol.data();
+        args.newIndex = newIndex.data();
+        args.newCell = newCell.data();
+        args.foodHit = foodHit.data();
+        advanceHeads(args, begin, end);
+
+        for (int game = begin; game < end; game++) {
+            if (done[game]) {
+                foodEaten[game] = 0;
+                episodeEnded[game] = 0;
+                continue;
+            }
+            int scoreBefore = scores[game];
+            completeStep(game);
+            foodEaten[game] = scores[game] != scoreBefore;
+            episodeEnded[game] = done[game] != 0;
+            if (done[game]) {
+                episodeScores[game] = scores[game];
+                episodeLengths[game] = lengths[game];
+                if (autoReset) {
+                    uint64_t episode = ++episodeCounts[game];
+                    reset(game, autoResetSeed, episode * gameCount + game);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Gets one game's board as a row-major cell buffer.
+     * @param game Game index
+     * @return Pointer to rows * cols cells
+     */
+    const uint8_t* getCells(int game) const {
+        return &cells[static_cast<size_t>(game) * cellCount];
+    }
+
+    int getCellType(int game, int r, int c) const {
+        if (r < 0 || r >= rows || c < 0 || c >= cols) return WALL;
+        return getCells(game)[r * cols + c];
+    }
+
+    pair<int, int> getHead(int game) const { return {headRow[game], headCol[game]}; }
+    pair<int, int> getTail(int game) const { int t = tailIndex(game); return {t / cols, t % cols}; }
+    int getFoodIndex(int game) const { return foodIndex[game]; }
+    Direction getDirection(int game) const { return static_cast<Direction>(directions[game]); }
+    int getLength(int game) const { return lengths[game]; }
+    int getScore(int game) const { return scores[game]; }
+    bool isDone(int game) const { return done[game] != 0; }
+    bool isAutoReset() const { return autoReset; }
+    bool wasFoodEaten(int game) const { return foodEaten[game] != 0; }
+    bool didEpisodeEnd(int game) const { return episodeEnded[game] != 0; }
+    int getEpisodeScore(int game) const { return episodeScores[game]; }
+    int getEpisodeLength(int game) const { return episodeLengths[game]; }
+    int getGameCount() const { return gameCount; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+};
+
+#endif // BATCHENGINE_H
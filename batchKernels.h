@@ -0,0 +1,247 @@
+// batchKernels.h
+#ifndef BATCHKERNELS_H
+#define BATCHKERNELS_H
+
+#include "gameLogic.h"
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SNAKE_X86_KERNELS 1
+    #include <immintrin.h>
+#endif
+
+// ============================================================================
+// BATCH HEAD-ADVANCE KERNELS
+// ============================================================================
+
+static_assert(sizeof(Direction) == sizeof(int32_t), "Direction arrays are read as int32 lanes");
+
+/**
+ * @brief Inputs and outputs of one head-advance pass over a batch of games.
+ *
+ * All per-game arrays are indexed by game. The kernel covers the
+ * data-parallel part of a tick: input validation, the
+ * DirectionController::getNextPosition() delta add, the isOutOfBounds()
+ * test, the occupancy lookup of the target cell and the food-hit test.
+ * The cell slab must have at least 3 bytes of padding past its end, since
+ * the vector kernels load cells as 32-bit words.
+ */
+struct HeadAdvanceArgs {
+    int rows;
+    int cols;
+    int cellCount;
+    const int32_t* actions;         ///< Requested Direction per game
+    int32_t* directions;            ///< Current Direction per game, updated in place
+    const int32_t* headRow;
+    const int32_t* headCol;
+    const int32_t* foodIndex;       ///< Flat food cell, or -1 when no food
+    const int32_t* done;            ///< Non-zero for finished games (left untouched)
+    const uint8_t* cells;           ///< Board slab, cellCount bytes per game
+    int32_t* newRow;
+    int32_t* newCol;
+    int32_t* newIndex;              ///< Flat target cell, 0 when out of bounds
+    int32_t* newCell;               ///< CellType of the target, WALL when out of bounds
+    int32_t* foodHit;               ///< Non-zero when the target holds the food
+};
+
+enum class KernelLevel {
+    SCALAR,
+    SSE42,
+    AVX2
+};
+
+/**
+ * @brief Head-advance kernels with a scalar fallback and runtime dispatch.
+ */
+class BatchKernels {
+public:
+    using KernelFunction = void (*)(const HeadAdvanceArgs&, int, int);
+
+    /**
+     * @brief Reference implementation, one game at a time.
+     * @param args Batch arrays
+     * @param begin First game
+     * @param end One past the last game
+     */
+    static void advanceHeadsScalar(const HeadAdvanceArgs& args, int begin, int end) {
+        for (int game = begin; game < end; game++) {
+            int dir = args.directions[game];
+            int action = args.actions[game];
+            if (!args.done[game] && action != NONE && action != (dir ^ 1)) {
+                dir = action;
+                args.directions[game] = dir;
+            }
+
+            int r = args.headRow[game] + (dir == DOWN) - (dir == UP);
+            int c = args.headCol[game] + (dir == RIGHT) - (dir == LEFT);
+            bool outOfBounds = r < 0 || r >= args.rows || c < 0 || c >= args.cols;
+            int index = outOfBounds ? 0 : r * args.cols + c;
+
+            args.newRow[game] = r;
+            args.newCol[game] = c;
+            args.newIndex[game] = index;
+            args.newCell[game] = outOfBounds
+                ? static_cast<int32_t>(WALL)
+                : args.cells[static_cast<size_t>(game) * args.cellCount + index];
+            args.foodHit[game] = !outOfBounds && index == args.foodIndex[game];
+        }
+    }
+
+#ifdef SNAKE_X86_KERNELS
+    /**
+     * @brief Four games per iteration; the cell lookup stays scalar since
+     *        SSE has no gather.
+     */
+    __attribute__((target("sse4.2")))
+    static void advanceHeadsSse42(const HeadAdvanceArgs& args, int begin, int end) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i none = _mm_set1_epi32(NONE);
+        const __m128i up = _mm_set1_epi32(UP);
+        const __m128i down = _mm_set1_epi32(DOWN);
+        const __m128i left = _mm_set1_epi32(LEFT);
+        const __m128i right = _mm_set1_epi32(RIGHT);
+        const __m128i maxRow = _mm_set1_epi32(args.rows - 1);
+        const __m128i maxCol = _mm_set1_epi32(args.cols - 1);
+        const __m128i cols = _mm_set1_epi32(args.cols);
+        const __m128i wall = _mm_set1_epi32(WALL);
+
+        int game = begin;
+        for (; game + 4 <= end; game += 4) {
+            __m128i dir = _mm_loadu_si128(reinterpret_cast<const __m128i*>(args.directions + game));
+            __m128i action = _mm_loadu_si128(reinterpret_cast<const __m128i*>(args.actions + game));
+            __m128i active = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(args.done + game)), zero);
+            __m128i reversed = _mm_cmpeq_epi32(action, _mm_xor_si128(dir, one));
+            __m128i accept = _mm_andnot_si128(_mm_or_si128(reversed, _mm_cmpeq_epi32(action, none)), active);
+            dir = _mm_blendv_epi8(dir, action, accept);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(args.directions + game), dir);
+
+            // Compare masks are -1 where true, so subtracting them adds one
+            __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(args.headRow + game));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(args.headCol + game));
+            r = _mm_add_epi32(r, _mm_sub_epi32(_mm_cmpeq_epi32(dir, up), _mm_cmpeq_epi32(dir, down)));
+            c = _mm_add_epi32(c, _mm_sub_epi32(_mm_cmpeq_epi32(dir, left), _mm_cmpeq_epi32(dir, right)));
+
+            __m128i outOfBounds = _mm_or_si128(
+                _mm_or_si128(_mm_cmplt_epi32(r, zero), _mm_cmpgt_epi32(r, maxRow)),
+                _mm_or_si128(_mm_cmplt_epi32(c, zero), _mm_cmpgt_epi32(c, maxCol)));
+            __m128i index = _mm_andnot_si128(outOfBounds, _mm_add_epi32(_mm_mullo_epi32(r, cols), c));
+            __m128i food = _mm_loadu_si128(reinterpret_cast<const __m128i*>(args.foodIndex + game));
+            __m128i hit = _mm_andnot_si128(outOfBounds, _mm_cmpeq_epi32(index, food));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(args.newRow + game), r);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(args.newCol + game), c);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(args.newIndex + game), index);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(args.foodHit + game), _mm_and_si128(hit, one));
+
+            alignas(16) int32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), index);
+            __m128i cell = _mm_setr_epi32(
+                args.cells[static_cast<size_t>(game) * args.cellCount + lanes[0]],
+                args.cells[static_cast<size_t>(game + 1) * args.cellCount + lanes[1]],
+                args.cells[static_cast<size_t>(game + 2) * args.cellCount + lanes[2]],
+                args.cells[static_cast<size_t>(game + 3) * args.cellCount + lanes[3]]);
+            cell = _mm_blendv_epi8(cell, wall, outOfBounds);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(args.newCell + game), cell);
+        }
+        advanceHeadsScalar(args, game, end);
+    }
+
+    /**
+     * @brief Eight games per iteration, with the cell lookup done as a
+     *        32-bit gather relative to the first game of the group.
+     */
+    __attribute__((target("avx2")))
+    static void advanceHeadsAvx2(const HeadAdvanceArgs& args, int begin, int end) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i none = _mm256_set1_epi32(NONE);
+        const __m256i up = _mm256_set1_epi32(UP);
+        const __m256i down = _mm256_set1_epi32(DOWN);
+        const __m256i left = _mm256_set1_epi32(LEFT);
+        const __m256i right = _mm256_set1_epi32(RIGHT);
+        const __m256i maxRow = _mm256_set1_epi32(args.rows - 1);
+        const __m256i maxCol = _mm256_set1_epi32(args.cols - 1);
+        const __m256i cols = _mm256_set1_epi32(args.cols);
+        const __m256i wall = _mm256_set1_epi32(WALL);
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256i laneBase = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                    _mm256_set1_epi32(args.cellCount));
+
+        int game = begin;
+        for (; game + 8 <= end; game += 8) {
+            __m256i dir = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(args.directions + game));
+            __m256i action = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(args.actions + game));
+            __m256i active = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(args.done + game)), zero);
+            __m256i reversed = _mm256_cmpeq_epi32(action, _mm256_xor_si256(dir, one));
+            __m256i accept = _mm256_andnot_si256(_mm256_or_si256(reversed, _mm256_cmpeq_epi32(action, none)), active);
+            dir = _mm256_blendv_epi8(dir, action, accept);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(args.directions + game), dir);
+
+            __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(args.headRow + game));
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(args.headCol + game));
+            r = _mm256_add_epi32(r, _mm256_sub_epi32(_mm256_cmpeq_epi32(dir, up), _mm256_cmpeq_epi32(dir, down)));
+            c = _mm256_add_epi32(c, _mm256_sub_epi32(_mm256_cmpeq_epi32(dir, left), _mm256_cmpeq_epi32(dir, right)));
+
+            __m256i outOfBounds = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpgt_epi32(zero, r), _mm256_cmpgt_epi32(r, maxRow)),
+                _mm256_or_si256(_mm256_cmpgt_epi32(zero, c), _mm256_cmpgt_epi32(c, maxCol)));
+            __m256i index = _mm256_andnot_si256(outOfBounds, _mm256_add_epi32(_mm256_mullo_epi32(r, cols), c));
+            __m256i food = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(args.foodIndex + game));
+            __m256i hit = _mm256_andnot_si256(outOfBounds, _mm256_cmpeq_epi32(index, food));
+
+            const int* groupCells = reinterpret_cast<const int*>(
+                args.cells + static_cast<size_t>(game) * args.cellCount);
+            __m256i cell = _mm256_and_si256(
+                _mm256_i32gather_epi32(groupCells, _mm256_add_epi32(laneBase, index), 1), byteMask);
+            cell = _mm256_blendv_epi8(cell, wall, outOfBounds);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(args.newRow + game), r);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(args.newCol + game), c);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(args.newIndex + game), index);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(args.newCell + game), cell);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(args.foodHit + game), _mm256_and_si256(hit, one));
+        }
+        advanceHeadsScalar(args, game, end);
+    }
+#endif
+
+    /**
+     * @brief Gets the best kernel level this CPU supports.
+     * @return AVX2, SSE4.2 or SCALAR
+     */
+    static KernelLevel detectLevel() {
+#ifdef SNAKE_X86_KERNELS
+        if (__builtin_cpu_supports("avx2")) return KernelLevel::AVX2;
+        if (__builtin_cpu_supports("sse4.2")) return KernelLevel::SSE42;
+#endif
+        return KernelLevel::SCALAR;
+    }
+
+    /**
+     * @brief Gets the kernel for a level, falling back to the best one the
+     *        CPU supports when the requested level is unavailable.
+     * @param level Requested level
+     * @return Kernel function
+     */
+    static KernelFunction select(KernelLevel level) {
+        KernelLevel supported = detectLevel();
+        if (static_cast<int>(level) > static_cast<int>(supported)) level = supported;
+#ifdef SNAKE_X86_KERNELS
+        if (level == KernelLevel::AVX2) return advanceHeadsAvx2;
+        if (level == KernelLevel::SSE42) return advanceHeadsSse42;
+#endif
+        return advanceHeadsScalar;
+    }
+
+    static string levelName(KernelLevel level) {
+        switch (level) {
+            case KernelLevel::SCALAR: return "scalar";
+            case KernelLevel::SSE42:  return "sse4.2";
+            case KernelLevel::AVX2:   return "avx2";
+        }
+        return "unknown";
+    }
+};
+
+#endif // BATCHKERNELS_H
@@ -0,0 +1,193 @@
+// batchPipeline.h
+#ifndef BATCHPIPELINE_H
+#define BATCHPIPELINE_H
+
+#include "batchEngine.h"
+#include "observationEncoder.h"
+#include "workStealingPool.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// ============================================================================
+// DOUBLE-BUFFERED BATCH PIPELINE
+// ============================================================================
+
+/**
+ * @brief One half of a BatchPipeline: a batch of auto-resetting games and
+ *        the buffers exchanged with the caller.
+ */
+struct PipelineBatch {
+    int id;
+    BatchSnakeEngine engine;
+    vector<float> observations;     ///< Encoded planes, gameCount * observationSize
+    vector<float> rewards;          ///< +1 per food, -1 on death
+    vector<uint8_t> dones;          ///< 1 when the step ended an episode
+    vector<int32_t> episodeScores;  ///< Final score where dones is 1
+    vector<int32_t> actions;        ///< Directions filled by the caller before submit();
+                                    ///< other values count as NONE
+    vector<Direction> stepActions;  ///< Validated copy of actions
+    bool ready;                     ///< Stepped and waiting for the caller
+    bool acquired;                  ///< Handed out by acquire() and not submitted since
+
+    PipelineBatch(int id, int gameCount, int rows, int cols, size_t observationSize)
+        : id(id), engine(gameCount, rows, cols, 3, 1, RIGHT),
+          observations(gameCount * observationSize), rewards(gameCount), dones(gameCount),
+          episodeScores(gameCount), actions(gameCount, NONE), stepActions(gameCount, NONE),
+          ready(true), acquired(false) {}
+};
+
+/**
+ * @brief Overlaps environment stepping with the caller's inference.
+ *
+ * Holds two batches of games. The caller acquires a batch, reads its
+ * observations, fills its actions and submits it; a stepper thread then
+ * steps and encodes that batch (split across a WorkStealingPool) while the
+ * caller acquires and works on the other one. Games auto-reset in place,
+ * so the loop never stops to restart episodes and nothing is allocated
+ * after construction.
+ *
+ * Usage: acquire() hands out the batches alternately; submit each batch
+ * before acquiring the one after it. submit() refuses a batch that is not
+ * currently acquired, so at most both batches are ever pending.
+ */
+class BatchPipeline {
+private:
+    static constexpr int ChunkGames = 64;
+
+    int cropRadius;
+    size_t observationSize;
+    ObservationEncoder encoder;
+    unique_ptr<PipelineBatch> batches[2];
+    int nextAcquire;
+
+    WorkStealingPool pool;
+    thread stepper;
+    mutex batchMutex;
+    condition_variable batchSubmitted;
+    condition_variable batchReady;
+    int pending[2];                 ///< FIFO of submitted batch ids
+    int pendingCount;
+    bool stopping;
+
+    /**
+     * @brief Steps and encodes one batch, chunked across the pool.
+     */
+    void stepBatch(PipelineBatch& batch) {
+        BatchSnakeEngine& engine = batch.engine;
+        int gameCount = engine.getGameCount();
+        uint32_t chunkCount = (gameCount + ChunkGames - 1) / ChunkGames;
+        pool.parallelFor(chunkCount, [&](int, uint32_t chunk) {
+            int begin = static_cast<int>(chunk) * ChunkGames;
+            int end = min(gameCount, begin + ChunkGames);
+            for (int game = begin; game < end; game++) {
+                int32_t action = batch.actions[game];
+                batch.stepActions[game] = action >= UP && action <= NONE ? static_cast<Direction>(action) : NONE;
+            }
+            engine.stepRange(batch.stepActions.data(), begin, end);
+            int cellCount = engine.getRows() * engine.getCols();
+            for (int game = begin; game < end; game++) {
+                bool ended = engine.didEpisodeEnd(game);
+                bool died = ended && engine.getEpisodeLength(game) < cellCount;
+                batch.rewards[game] = (engine.wasFoodEaten(game) ? 1.0f : 0.0f) - (died ? 1.0f : 0.0f);
+                batch.dones[game] = ended;
+                batch.episodeScores[game] = ended ? engine.getEpisodeScore(game) : 0;
+            }
+            encoder.encodeBatch(engine, cropRadius, batch.observations.data(), begin, end);
+        });
+    }
+
+    void stepperMain() {
+        while (true) {
+            PipelineBatch* batch;
+            {
+                unique_lock<mutex> lock(batchMutex);
+                batchSubmitted.wait(lock, [&] { return stopping || pendingCount > 0; });
+                if (stopping) return;
+                batch = batches[pending[0]].get();
+            }
+            stepBatch(*batch);
+            {
+                lock_guard<mutex> lock(batchMutex);
+                pending[0] = pending[1];
+                pendingCount--;
+                batch->ready = true;
+            }
+            batchReady.notify_all();
+        }
+    }
+
+public:
+    /**
+     * @brief Creates and resets both batches and starts the stepper.
+     * @param gamesPerBatch Games in each of the two batches
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param cropRadius Egocentric radius, or -1 for whole-board observations
+     * @param threads Stepping threads, including the stepper; 0 uses every core
+     * @param seed Batch b, game i, episode k uses stream (k * gamesPerBatch + i) of seed + b
+     */
+    BatchPipeline(int gamesPerBatch, int rows, int cols, int cropRadius, int threads, uint64_t seed)
+        : cropRadius(cropRadius),
+          observationSize(ObservationEncoder::observationSize(rows, cols, cropRadius)),
+          nextAcquire(0), pool(threads), pending{0, 0}, pendingCount(0), stopping(false) {
+        for (int b = 0; b < 2; b++) {
+            batches[b] = make_unique<PipelineBatch>(b, gamesPerBatch, rows, cols, observationSize);
+            BatchSnakeEngine& engine = batches[b]->engine;
+            engine.resetAll(seed + b);
+            engine.setAutoReset(true, seed + b);
+            encoder.encodeBatch(engine, cropRadius, batches[b]->observations.data());
+        }
+        stepper = thread(&BatchPipeline::stepperMain, this);
+    }
+
+    ~BatchPipeline() {
+        {
+            lock_guard<mutex> lock(batchMutex);
+            stopping = true;
+        }
+        batchSubmitted.notify_one();
+        stepper.join();
+    }
+
+    BatchPipeline(const BatchPipeline&) = delete;
+    BatchPipeline& operator=(const BatchPipeline&) = delete;
+
+    /**
+     * @brief Waits for the next batch to finish stepping.
+     * @return Batch whose observations, rewards and dones are current
+     */
+    PipelineBatch& acquire() {
+        PipelineBatch& batch = *batches[nextAcquire];
+        nextAcquire ^= 1;
+        unique_lock<mutex> lock(batchMutex);
+        batchReady.wait(lock, [&] { return batch.ready; });
+        batch.acquired = true;
+        return batch;
+    }
+
+    /**
+     * @brief Hands a batch back for stepping with the actions it holds.
+     * @param batch Batch returned by acquire()
+     * @return False, queuing nothing, if the batch was never acquired or is
+     *         already submitted
+     */
+    bool submit(PipelineBatch& batch) {
+        {
+            lock_guard<mutex> lock(batchMutex);
+            if (!batch.acquired) return false;
+            batch.acquired = false;
+            batch.ready = false;
+            pending[pendingCount++] = batch.id;
+        }
+        batchSubmitted.notify_one();
+        return true;
+    }
+
+    PipelineBatch& getBatch(int id) { return *batches[id]; }
+    size_t getObservationSize() const { return observationSize; }
+    int getGamesPerBatch() const { return batches[0]->engine.getGameCount(); }
+    int getThreadCount() const { return pool.getWorkerCount(); }
+};
+
+#endif // BATCHPIPELINE_H
@@ -0,0 +1,1484 @@
+// benchmark.cpp
+// Engine micro-benchmarks. Build with optimizations, e.g.
+//   g++ -std=c++20 -O2 benchmark.cpp -o snake_benchmark
+// and run `./snake_benchmark` for all suites or `./snake_benchmark <suite>`.
+
+#include "gameLogic.h"
+#include "gameHistory.h"
+#include "bitboardLogic.h"
+#include "batchEngine.h"
+#include "rolloutRunner.h"
+#include "observationEncoder.h"
+#include "batchPipeline.h"
+#include "mctsAutopilot.h"
+#include "bfsAutopilot.h"
+#include "hamiltonAutopilot.h"
+#include "floodFill.h"
+#include "distanceField.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <new>
+#include <cstdlib>
+
+using namespace std;
+
+// ============================================
+// Heap Allocation Counter
+// ============================================
+
+static atomic<long long> heapAllocations(0);
+static atomic<long long> heapBytes(0);
+
+// Replaces the plain and array forms together. The out-of-line helpers keep
+// GCC from inlining malloc/free into new/delete pairs and then reporting
+// them as mismatched (-Wmismatched-new-delete).
+__attribute__((noinline)) static void* countedAllocate(size_t size) {
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    heapBytes.fetch_add(size, memory_order_relaxed);
+    if (void* memory = malloc(size ? size : 1)) return memory;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) static void countedRelease(void* memory) noexcept { free(memory); }
+
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* memory) noexcept { countedRelease(memory); }
+void operator delete[](void* memory) noexcept { countedRelease(memory); }
+void operator delete(void* memory, size_t) noexcept { countedRelease(memory); }
+void operator delete[](void* memory, size_t) noexcept { countedRelease(memory); }
+
+// ============================================
+// Shared Helpers
+// ============================================
+
+/**
+ * @brief Greedy food-seeking policy used to drive every engine identically.
+ *
+ * Picks a non-reversing move into a free in-bounds cell, preferring moves
+ * that get closer to the food. Only needs getCellType(), the snake head and
+ * the food position, so it works with any engine exposing those.
+ */
+class GreedyPolicy {
+private:
+    mt19937 rng;
+
+public:
+    explicit GreedyPolicy(unsigned int seed) : rng(seed) {}
+
+    template <typename BoardType>
+    Direction choose(const BoardType& board, pair<int, int> head, pair<int, int> food,
+                     Direction current) {
+        static const int dr[] = {-1, 1, 0, 0};
+        static const int dc[] = {0, 0, -1, 1};
+        static const Direction reverse[] = {DOWN, UP, RIGHT, LEFT, NONE};
+
+        Direction best = current;
+        int bestScore = -1;
+        for (int d = 0; d < 4; d++) {
+            if (d == reverse[current]) continue;
+            int r = head.first + dr[d];
+            int c = head.second + dc[d];
+            int cell = board.getCellType(r, c);
+            if (cell == SNAKE || cell == WALL) continue;
+
+            int distance = abs(food.first - r) + abs(food.second - c);
+            int score = (1 << 20) - distance * 16 + static_cast<int>(rng() & 15);
+            if (score > bestScore) {
+                bestScore = score;
+                best = static_cast<Direction>(d);
+            }
+        }
+        return best;
+    }
+};
+
+/**
+ * @brief Runtime-sized rules without snapshot publishing.
+ *
+ * Isolates the cost of runtime dimensions from the cost of publishing when
+ * comparing against FixedSnakeGameLogic.
+ */
+class UnpublishedGameLogic {
+private:
+    Xoshiro256 rng;
+    Board board;
+    Snake snake;
+    FoodManager foodManager;
+    DirectionController directionController;
+    int score;
+    bool gameOver;
+
+public:
+    UnpublishedGameLogic() : foodManager(rng), score(0), gameOver(false) {}
+
+    void initializeBoard(int rows, int cols, int startingLength, Direction initialDirection) {
+        score = 0;
+        gameOver = false;
+        board.initialize(rows, cols);
+        directionController.initialize(initialDirection);
+        snake.initialize({rows / 2, cols / 2}, startingLength, initialDirection, board);
+        foodManager.placeRandom(board);
+    }
+
+    void setDirection(Direction dir) { directionController.setInput(dir); }
+
+    bool update() {
+        if (gameOver) return false;
+        gameOver = GameRules::tick(board, snake, foodManager, directionController, score, 10) != NOT_OVER;
+        return !gameOver;
+    }
+
+    const Board& getBoard() const { return board; }
+    const Snake& getSnake() const { return snake; }
+    const FoodManager& getFoodManager() const { return foodManager; }
+    Direction getCurrentDirection() const { return directionController.getCurrent(); }
+};
+
+/**
+ * @brief Plays games back to back until a tick budget is spent.
+ * @param reset Starts a new game on the engine
+ * @param engine Engine exposing setDirection/update and game-thread accessors
+ * @param totalTicks Number of ticks to run
+ * @return Ticks per second
+ */
+template <typename Engine>
+double measureTicks(Engine& engine, const function<void()>& reset, long long totalTicks) {
+    GreedyPolicy policy(12345);
+    reset();
+
+    auto start = chrono::steady_clock::now();
+    for (long long tick = 0; tick < totalTicks; tick++) {
+        engine.setDirection(policy.choose(engine.getBoard(), engine.getSnake().getHead(),
+                                          engine.getFoodManager().getPosition(),
+                                          engine.getCurrentDirection()));
+        if (!engine.update()) {
+            reset();
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return totalTicks / elapsed.count();
+}
+
+void printRow(const string& label, double perSecond, double baseline,
+              const string& unit = "ticks/s") {
+    cout << "  " << left << setw(34) << label << right
+         << setw(14) << fixed << setprecision(0) << perSecond << " " << unit
+         << setw(9) << setprecision(2) << perSecond / baseline << "x\n";
+}
+
+// ============================================
+// Suite: Bitboard Engine
+// ============================================
+
+/**
+ * @brief Checks that both engines show the same state after a tick.
+ */
+bool bitboardMatches(const SnakeGameLogic& game, const BitboardSnakeGame& bitboard) {
+    if (game.hasEnded() != bitboard.isGameOver() || game.getCurrentScore() != bitboard.getScore() ||
+        static_cast<int>(game.getSnake().getLength()) != bitboard.getLength() ||
+        game.getSnake().getHead() != bitboard.getHead() ||
+        game.getFoodManager().isPresent() != bitboard.isFoodPresent()) {
+        return false;
+    }
+    if (game.getFoodManager().isPresent() &&
+        game.getFoodManager().getPosition() != bitboard.getFoodPosition()) {
+        return false;
+    }
+    const Board& board = game.getBoard();
+    for (int r = 0; r < board.getRows(); r++) {
+        for (int c = 0; c < board.getCols(); c++) {
+            if (board.getCellType(r, c) != bitboard.getCellType(r, c)) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Plays one game on SnakeGameLogic and BitboardSnakeGame in lockstep.
+ *
+ * The engines draw food from differently ordered empty-cell sets, so the
+ * bitboard copies every placement with placeFoodAt(). Moves are greedy with
+ * an occasional random one, so games end by every rule.
+ * @return Tick of the first mismatch (0 = after initializeBoard()), or -1
+ */
+int findBitboardMismatch(int rows, int cols, int startingLength, Direction direction,
+                         uint64_t seed) {
+    SnakeGameLogic game(seed);
+    game.setPublishing(false);
+    game.initializeBoard(rows, cols, startingLength, 10, direction);
+    BitboardSnakeGame bitboard;
+    bitboard.initializeBoard(rows, cols, startingLength, 10, direction);
+
+    GreedyPolicy policy(static_cast<unsigned int>(seed));
+    Xoshiro256 rng(seed, 1);
+    for (int tick = 0; ; tick++) {
+        if (game.getFoodManager().isPresent()) {
+            pair<int, int> food = game.getFoodManager().getPosition();
+            bitboard.placeFoodAt(food.first, food.second);
+        }
+        if (!bitboardMatches(game, bitboard)) return tick;
+        if (game.hasEnded() || tick == 20000) return -1;
+
+        Direction dir = rng.nextBounded(16) == 0
+            ? static_cast<Direction>(rng.nextBounded(4))
+            : policy.choose(bitboard, bitboard.getHead(), bitboard.getFoodPosition(),
+                            bitboard.getCurrentDirection());
+        game.setDirection(dir);
+        bitboard.setDirection(dir);
+        if (game.update() != bitboard.update()) return tick + 1;
+    }
+}
+
+void benchmarkBitboard() {
+    cout << "\n== Bitboard engine vs SnakeGameLogic ==\n";
+
+    // Small boards and long starting bodies leave segments off the board
+    struct Case { int rows, cols, length; };
+    const Case cases[] = {{2, 2, 3}, {3, 3, 3}, {4, 3, 3}, {2, 6, 5}, {5, 5, 6},
+                          {10, 10, 3}, {8, 70, 40}, {20, 40, 3}};
+    int mismatches = 0;
+    for (const Case& test : cases) {
+        for (Direction direction : {UP, DOWN, LEFT, RIGHT}) {
+            for (uint64_t seed = 0; seed < 200; seed++) {
+                int tick = findBitboardMismatch(test.rows, test.cols, test.length, direction, seed);
+                if (tick < 0) continue;
+                if (mismatches++ < 5) {
+                    cout << "  mismatch: " << test.rows << "x" << test.cols << " length "
+                         << test.length << " direction " << direction << " seed " << seed
+                         << " at tick " << tick << "\n";
+                }
+            }
+        }
+    }
+    cout << "  games differing from SnakeGameLogic: " << mismatches << "\n";
+    if (mismatches > 0) {
+        exit(1);
+    }
+
+    const long long totalTicks = 2000000;
+    for (int side : {20, 64}) {
+        SnakeGameLogic game(7);
+        game.setPublishing(false);
+        double gameRate = measureTicks(game, [&] {
+            game.initializeBoard(side, side, 3, 10, RIGHT);
+        }, totalTicks);
+
+        BitboardSnakeGame bitboard;
+        bitboard.setSeed(7);
+        GreedyPolicy policy(12345);
+        bitboard.initializeBoard(side, side, 3, 10, RIGHT);
+        auto start = chrono::steady_clock::now();
+        for (long long tick = 0; tick < totalTicks; tick++) {
+            bitboard.setDirection(policy.choose(bitboard, bitboard.getHead(),
+                                                bitboard.getFoodPosition(),
+                                                bitboard.getCurrentDirection()));
+            if (!bitboard.update()) {
+                bitboard.initializeBoard(side, side, 3, 10, RIGHT);
+            }
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        cout << "\n  Board " << side << "x" << side << "\n";
+        printRow("SnakeGameLogic, no publishing", gameRate, gameRate);
+        printRow("BitboardSnakeGame", totalTicks / elapsed.count(), gameRate);
+    }
+}
+
+// ============================================
+// Suite: Compile-Time Board Dimensions
+// ============================================
+
+template <int Rows, int Cols>
+void benchmarkFixedSize(long long totalTicks) {
+    cout << "\n  Board " << Rows << "x" << Cols << "\n";
+
+    SnakeGameLogic published;
+    double publishedRate = measureTicks(published, [&] {
+        published.initializeBoard(Rows, Cols, 3, 10, RIGHT);
+    }, totalTicks);
+
+    UnpublishedGameLogic runtime;
+    double runtimeRate = measureTicks(runtime, [&] {
+        runtime.initializeBoard(Rows, Cols, 3, RIGHT);
+    }, totalTicks);
+
+    FixedSnakeGameLogic<Rows, Cols> fixedSize;
+    double fixedRate = measureTicks(fixedSize, [&] {
+        fixedSize.initializeBoard(3, 10, RIGHT);
+    }, totalTicks);
+
+    printRow("SnakeGameLogic (publishing)", publishedRate, publishedRate);
+    printRow("runtime Board, no publishing", runtimeRate, publishedRate);
+    printRow("FixedSnakeGameLogic<R, C>", fixedRate, publishedRate);
+}
+
+void benchmarkFixedDimensions() {
+    cout << "\n== Compile-time board dimensions ==\n";
+    const long long totalTicks = 2000000;
+    benchmarkFixedSize<10, 10>(totalTicks);
+    benchmarkFixedSize<20, 20>(totalTicks);
+    benchmarkFixedSize<20, 40>(totalTicks);
+}
+
+// ============================================
+// Suite: Delta Publishing
+// ============================================
+
+void benchmarkDeltaPublishing() {
+    cout << "\n== Full vs delta snapshot publishing ==\n";
+    const long long totalTicks = 200000;
+    const int sizes[][2] = {{20, 40}, {200, 400}};
+
+    for (auto& size : sizes) {
+        cout << "\n  Board " << size[0] << "x" << size[1] << "\n";
+        SnakeGameLogic full;
+        double fullRate = measureTicks(full, [&] {
+            full.initializeBoard(size[0], size[1], 3, 10, RIGHT);
+        }, totalTicks);
+
+        SnakeGameLogic delta;
+        delta.setDeltaPublishing(true);
+        double deltaRate = measureTicks(delta, [&] {
+            delta.initializeBoard(size[0], size[1], 3, 10, RIGHT);
+        }, totalTicks);
+
+        printRow("full snapshots", fullRate, fullRate);
+        printRow("delta snapshots", deltaRate, fullRate);
+    }
+}
+
+// ============================================
+// Suite: Snapshot Publisher
+// ============================================
+
+/**
+ * @brief The previous shared_ptr-based publisher, kept as a baseline.
+ */
+class SharedPtrStatePublisher {
+private:
+    atomic<shared_ptr<const GameState>> currentState;
+    shared_ptr<GameState> writeBuffer;
+    shared_ptr<GameState> readBuffer;
+
+public:
+    SharedPtrStatePublisher() {
+        writeBuffer = make_shared<GameState>();
+        readBuffer = make_shared<GameState>();
+        currentState.store(writeBuffer, memory_order_relaxed);
+    }
+
+    void publish(const Board& board, const Snake& snake, const FoodManager& foodManager,
+                 int score, bool gameOver) {
+        writeBuffer->rows = board.getRows();
+        writeBuffer->cols = board.getCols();
+        writeBuffer->score = score;
+        writeBuffer->gameOver = gameOver;
+        writeBuffer->food = foodManager.getPosition();
+        writeBuffer->foodExists = foodManager.isPresent();
+        snake.getBody().copyTo(writeBuffer->snake);
+        writeBuffer->snakeLength = snake.getLength();
+        writeBuffer->board = board.getCells();
+
+        currentState.store(writeBuffer, memory_order_release);
+        swap(writeBuffer, readBuffer);
+    }
+
+    shared_ptr<const GameState> getState() const {
+        return currentState.load(memory_order_acquire);
+    }
+};
+
+/**
+ * @brief Runs one writer publishing continuously against reader threads.
+ * @param readerCount Number of reader threads
+ * @param seconds Measurement duration
+ * @return Reader accessor calls per second (all readers combined)
+ */
+template <typename Publisher>
+double measurePublisher(Publisher& publisher, int readerCount, double seconds) {
+    Board board;
+    Snake snake;
+    Xoshiro256 rng(7);
+    FoodManager foodManager(rng);
+    board.initialize(20, 40);
+    snake.initialize({10, 20}, 3, RIGHT, board);
+    foodManager.placeRandom(board);
+    publisher.publish(board, snake, foodManager, 0, false);
+
+    atomic<bool> running(true);
+    atomic<long long> totalReads(0);
+    vector<thread> readers;
+    for (int i = 0; i < readerCount; i++) {
+        readers.emplace_back([&] {
+            long long reads = 0;
+            long long checksum = 0;
+            while (running.load(memory_order_relaxed)) {
+                // Mirrors SnakeGameLogic::getScore() / getCellType()
+                checksum += publisher.getState()->score;
+                checksum += publisher.getState()->cellAt(10, 20);
+                reads += 2;
+            }
+            totalReads += reads + (checksum == -1);
+        });
+    }
+
+    auto start = chrono::steady_clock::now();
+    int score = 0;
+    while (chrono::duration<double>(chrono::steady_clock::now() - start).count() < seconds) {
+        publisher.publish(board, snake, foodManager, score++, false);
+    }
+    running = false;
+    for (auto& reader : readers) reader.join();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return totalReads / elapsed.count();
+}
+
+void benchmarkPublisher() {
+    cout << "\n== Snapshot publisher, 20x40 board, writer publishing continuously ==\n";
+    for (int readerCount : {1, 4}) {
+        cout << "\n  " << readerCount << " reader thread(s), reader accessor calls\n";
+        SharedPtrStatePublisher sharedPublisher;
+        double sharedRate = measurePublisher(sharedPublisher, readerCount, 1.0);
+        StatePublisher pinnedPublisher(readerCount);
+        double pinnedRate = measurePublisher(pinnedPublisher, readerCount, 1.0);
+
+        cout << "  " << left << setw(34) << "atomic<shared_ptr> publisher" << right
+             << setw(14) << fixed << setprecision(0) << sharedRate << " reads/s\n";
+        cout << "  " << left << setw(34) << "pinned slot publisher" << right
+             << setw(14) << pinnedRate << " reads/s" << setw(9) << setprecision(2)
+             << pinnedRate / sharedRate << "x\n";
+    }
+}
+
+// ============================================
+// Suite: Per-Tick Allocations
+// ============================================
+
+void benchmarkAllocations() {
+    cout << "\n== Heap allocations per tick (steady state, games restarted in place) ==\n";
+    const long long totalTicks = 1000000;
+
+    for (bool delta : {false, true}) {
+        SnakeGameLogic game;
+        game.setDeltaPublishing(delta);
+        auto reset = [&] { game.initializeBoard(20, 40, 3, 10, RIGHT); };
+
+        // Warm up so first-game buffer sizing is not counted
+        measureTicks(game, reset, 10000);
+
+        long long heapBefore = heapAllocations.load();
+        uint64_t snapshotBefore = game.getSnapshotAllocationCount();
+        double rate = measureTicks(game, reset, totalTicks);
+        long long heapDelta = heapAllocations.load() - heapBefore;
+        uint64_t snapshotDelta = game.getSnapshotAllocationCount() - snapshotBefore;
+
+        cout << "  " << left << setw(22) << (delta ? "delta snapshots" : "full snapshots") << right
+             << setw(10) << heapDelta << " heap allocations, "
+             << snapshotDelta << " snapshot buffer growths over "
+             << totalTicks << " ticks (" << fixed << setprecision(0) << rate << " ticks/s)\n";
+    }
+}
+
+// ============================================
+// Suite: Snapshot History
+// ============================================
+
+void benchmarkHistory() {
+    cout << "\n== 10k-tick snapshot history, 200x400 board ==\n";
+    const int rows = 200;
+    const int cols = 400;
+    const int historyTicks = 10000;
+
+    for (bool delta : {true, false}) {
+        SnakeGameLogic game;
+        game.setDeltaPublishing(delta);
+        game.initializeBoard(rows, cols, 3, 10, RIGHT);
+        GameHistory history(historyTicks);
+        GreedyPolicy policy(99);
+
+        long long bytesBefore = heapBytes.load();
+        auto start = chrono::steady_clock::now();
+        for (int tick = 0; tick < historyTicks; tick++) {
+            game.setDirection(policy.choose(game.getBoard(), game.getSnake().getHead(),
+                                            game.getFoodManager().getPosition(),
+                                            game.getCurrentDirection()));
+            if (!game.update()) {
+                game.initializeBoard(rows, cols, 3, 10, RIGHT);
+            }
+            history.record(*game.getGameState());
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        double bytesPerTick = double(heapBytes.load() - bytesBefore) / historyTicks;
+
+        cout << "  " << left << setw(34) << (delta ? "delta snapshots (tile path copy)" : "full snapshots (tile compare)")
+             << right << setw(10) << fixed << setprecision(0) << bytesPerTick << " bytes/tick"
+             << setw(10) << setprecision(1) << historyTicks / elapsed.count() / 1000 << "k ticks/s\n";
+    }
+    cout << "  " << left << setw(34) << "one full grid copy (old int grid)" << right
+         << setw(10) << rows * cols * 4 << " bytes/tick\n";
+}
+
+// ============================================
+// Suite: Batched Stepping
+// ============================================
+
+/**
+ * @brief Builds a repeating table of mostly-forward random actions.
+ */
+vector<Direction> makeActionTable(size_t size, unsigned int seed) {
+    mt19937 rng(seed);
+    vector<Direction> actions(size);
+    for (auto& action : actions) {
+        action = rng() % 4 == 0 ? static_cast<Direction>(rng() % 4) : NONE;
+    }
+    return actions;
+}
+
+void benchmarkBatch() {
+    cout << "\n== 4096 games stepped together, 20x20 boards ==\n";
+    const int gameCount = 4096;
+    const int steps = 500;
+    vector<Direction> actionTable = makeActionTable(gameCount * 7 + 13, 5);
+
+    vector<unique_ptr<SnakeGameLogic>> games;
+    for (int i = 0; i < gameCount; i++) {
+        games.push_back(make_unique<SnakeGameLogic>());
+        games.back()->setDeltaPublishing(true);
+        games.back()->initializeBoard(20, 20, 3, 10, RIGHT);
+    }
+    auto start = chrono::steady_clock::now();
+    size_t cursor = 0;
+    for (int step = 0; step < steps; step++) {
+        for (int i = 0; i < gameCount; i++) {
+            games[i]->setDirection(actionTable[cursor++ % actionTable.size()]);
+            if (!games[i]->update()) {
+                games[i]->initializeBoard(20, 20, 3, 10, RIGHT);
+            }
+        }
+    }
+    chrono::duration<double> objectElapsed = chrono::steady_clock::now() - start;
+    double objectRate = double(gameCount) * steps / objectElapsed.count();
+
+    BatchSnakeEngine batch(gameCount, 20, 20, 3, 10, RIGHT);
+    batch.resetAll(1);
+    vector<Direction> actions(gameCount);
+    unsigned int nextSeed = gameCount + 1;
+    start = chrono::steady_clock::now();
+    cursor = 0;
+    for (int step = 0; step < steps; step++) {
+        for (int i = 0; i < gameCount; i++) {
+            actions[i] = actionTable[cursor++ % actionTable.size()];
+        }
+        batch.step(actions.data());
+        for (int i = 0; i < gameCount; i++) {
+            if (batch.isDone(i)) batch.reset(i, nextSeed++);
+        }
+    }
+    chrono::duration<double> batchElapsed = chrono::steady_clock::now() - start;
+    double batchRate = double(gameCount) * steps / batchElapsed.count();
+
+    printRow("4096 x SnakeGameLogic", objectRate, objectRate);
+    printRow("BatchSnakeEngine", batchRate, objectRate);
+}
+
+// ============================================
+// Suite: Batch Head-Advance Kernels
+// ============================================
+
+/**
+ * @brief Runs every available kernel on the same random batch and counts
+ *        games whose outputs differ from the scalar reference.
+ */
+int countKernelMismatches(int gameCount, int rows, int cols, unsigned int seed) {
+    int cellCount = rows * cols;
+    mt19937 rng(seed);
+    vector<int32_t> actions(gameCount), directions(gameCount), headRow(gameCount),
+                    headCol(gameCount), foodIndex(gameCount), done(gameCount);
+    vector<uint8_t> cells(static_cast<size_t>(gameCount) * cellCount + 3);
+    for (uint8_t& cell : cells) cell = static_cast<uint8_t>(rng() % 4);
+    for (int i = 0; i < gameCount; i++) {
+        actions[i] = static_cast<int32_t>(rng() % 5);
+        directions[i] = static_cast<int32_t>(rng() % 4);
+        headRow[i] = static_cast<int32_t>(rng() % rows);
+        headCol[i] = static_cast<int32_t>(rng() % cols);
+        foodIndex[i] = rng() % 8 == 0 ? -1 : static_cast<int32_t>(rng() % cellCount);
+        done[i] = rng() % 8 == 0;
+    }
+
+    auto run = [&](KernelLevel level, vector<int32_t> (&out)[6]) {
+        for (auto& column : out) column.assign(gameCount, -7);
+        out[0] = directions;
+        HeadAdvanceArgs args{rows, cols, cellCount, actions.data(), out[0].data(),
+                             headRow.data(), headCol.data(), foodIndex.data(), done.data(),
+                             cells.data(), out[1].data(), out[2].data(), out[3].data(),
+                             out[4].data(), out[5].data()};
+        BatchKernels::select(level)(args, 0, gameCount);
+    };
+
+    vector<int32_t> reference[6];
+    run(KernelLevel::SCALAR, reference);
+    int mismatches = 0;
+    for (KernelLevel level : {KernelLevel::SSE42, KernelLevel::AVX2}) {
+        if (static_cast<int>(level) > static_cast<int>(BatchKernels::detectLevel())) continue;
+        vector<int32_t> result[6];
+        run(level, result);
+        for (int i = 0; i < gameCount; i++) {
+            for (int k = 0; k < 6; k++) {
+                if (result[k][i] != reference[k][i]) {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+void benchmarkKernels() {
+    cout << "\n== Batch head-advance kernels, 4096 games, 20x20 boards ==\n";
+    cout << "  detected level: " << BatchKernels::levelName(BatchKernels::detectLevel()) << "\n";
+
+    // Odd sizes exercise the scalar tail after the vector loop
+    int mismatches = 0;
+    for (int gameCount : {1, 7, 13, 64, 1001}) {
+        mismatches += countKernelMismatches(gameCount, 20, 20, gameCount);
+        mismatches += countKernelMismatches(gameCount, 3, 50, gameCount + 1);
+    }
+    cout << "  kernel mismatches vs scalar: " << mismatches << "\n";
+    if (mismatches > 0) {
+        exit(1);
+    }
+
+    const int gameCount = 4096;
+    const int steps = 500;
+    const KernelLevel levels[] = {KernelLevel::SCALAR, KernelLevel::SSE42, KernelLevel::AVX2};
+    vector<Direction> actionTable = makeActionTable(gameCount * 7 + 13, 5);
+    vector<Direction> actions(gameCount);
+
+    cout << "  head advance only\n";
+    double kernelBaseline = 0;
+    for (KernelLevel level : levels) {
+        if (static_cast<int>(level) > static_cast<int>(BatchKernels::detectLevel())) continue;
+        BatchSnakeEngine batch(gameCount, 20, 20, 3, 10, RIGHT);
+        batch.resetAll(1);
+        vector<int32_t> directions(gameCount, RIGHT), headRow(gameCount), headCol(gameCount),
+                        foodIndex(gameCount), done(gameCount, 0), newRow(gameCount),
+                        newCol(gameCount), newIndex(gameCount), newCell(gameCount),
+                        foodHit(gameCount);
+        for (int i = 0; i < gameCount; i++) {
+            headRow[i] = batch.getHead(i).first;
+            headCol[i] = batch.getHead(i).second;
+            foodIndex[i] = batch.getFoodIndex(i);
+        }
+        vector<uint8_t> cells(static_cast<size_t>(gameCount) * 400 + 3);
+        for (int i = 0; i < gameCount; i++) {
+            memcpy(&cells[static_cast<size_t>(i) * 400], batch.getCells(i), 400);
+        }
+        HeadAdvanceArgs args{20, 20, 400, reinterpret_cast<const int32_t*>(actions.data()),
+                             directions.data(), headRow.data(), headCol.data(),
+                             foodIndex.data(), done.data(), cells.data(), newRow.data(),
+                             newCol.data(), newIndex.data(), newCell.data(), foodHit.data()};
+        BatchKernels::KernelFunction kernel = BatchKernels::select(level);
+
+        size_t cursor = 0;
+        auto start = chrono::steady_clock::now();
+        for (int step = 0; step < steps * 4; step++) {
+            for (int i = 0; i < gameCount; i++) {
+                actions[i] = actionTable[cursor++ % actionTable.size()];
+            }
+            kernel(args, 0, gameCount);
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        double rate = double(gameCount) * steps * 4 / elapsed.count();
+        if (kernelBaseline == 0) kernelBaseline = rate;
+        printRow(BatchKernels::levelName(level), rate, kernelBaseline);
+    }
+
+    cout << "  full BatchSnakeEngine::step\n";
+    double stepBaseline = 0;
+    for (KernelLevel level : levels) {
+        if (static_cast<int>(level) > static_cast<int>(BatchKernels::detectLevel())) continue;
+        BatchSnakeEngine batch(gameCount, 20, 20, 3, 10, RIGHT);
+        batch.setKernelLevel(level);
+        batch.resetAll(1);
+        unsigned int nextSeed = gameCount + 1;
+        size_t cursor = 0;
+        auto start = chrono::steady_clock::now();
+        for (int step = 0; step < steps; step++) {
+            for (int i = 0; i < gameCount; i++) {
+                actions[i] = actionTable[cursor++ % actionTable.size()];
+            }
+            batch.step(actions.data());
+            for (int i = 0; i < gameCount; i++) {
+                if (batch.isDone(i)) batch.reset(i, nextSeed++);
+            }
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        double rate = double(gameCount) * steps / elapsed.count();
+        if (stepBaseline == 0) stepBaseline = rate;
+        printRow(BatchKernels::levelName(level), rate, stepBaseline);
+    }
+}
+
+// ============================================
+// Suite: Parallel Rollouts
+// ============================================
+
+void benchmarkRollouts() {
+    int cores = max(1, static_cast<int>(thread::hardware_concurrency()));
+    cout << "\n== Work-stealing rollouts, greedy policy, 20x40 boards, "
+         << cores << " hardware thread(s) ==\n";
+    const uint32_t episodes = 20000;
+
+    RolloutConfig config;
+    config.seed = 7;
+    double baseline = 0;
+    for (int threads = 1; ; threads = min(threads * 2, cores)) {
+        RolloutRunner runner(config, [](uint64_t) {
+            return make_unique<GreedyAutopilot>();
+        }, threads);
+        auto start = chrono::steady_clock::now();
+        RolloutStats stats = runner.run(episodes);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        double rate = stats.totalTicks / elapsed.count();
+        if (baseline == 0) baseline = rate;
+        printRow(to_string(threads) + " thread(s), " + to_string(runner.getStealCount()) + " steals",
+                 rate, baseline);
+        if (threads == cores) break;
+    }
+}
+
+// ============================================
+// Suite: Observation Encoding
+// ============================================
+
+/**
+ * @brief Per-cell reference encoder with a switch, as the renderer does.
+ */
+template <typename T>
+void encodeWithSwitch(const uint8_t* cells, int rows, int cols, int headRow, int headCol,
+                      int radius, T* out) {
+    bool crop = radius >= 0;
+    int height = crop ? 2 * radius + 1 : rows;
+    int width = crop ? 2 * radius + 1 : cols;
+    size_t planeSize = static_cast<size_t>(height) * width;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int r = crop ? headRow - radius + y : y;
+            int c = crop ? headCol - radius + x : x;
+            int cell = r < 0 || r >= rows || c < 0 || c >= cols ? static_cast<int>(WALL) : cells[r * cols + c];
+            size_t i = static_cast<size_t>(y) * width + x;
+            for (int plane = 0; plane < PLANE_COUNT; plane++) out[plane * planeSize + i] = T(0);
+            switch (cell) {
+                case SNAKE:
+                    out[((r == headRow && c == headCol) ? PLANE_HEAD : PLANE_BODY) * planeSize + i] = T(1);
+                    break;
+                case FOOD: out[PLANE_FOOD * planeSize + i] = T(1); break;
+                case WALL: out[PLANE_WALL * planeSize + i] = T(1); break;
+            }
+        }
+    }
+}
+
+template <typename T>
+int countEncoderMismatches(const BatchSnakeEngine& batch, int radius) {
+    int rows = batch.getRows();
+    int cols = batch.getCols();
+    size_t size = ObservationEncoder::observationSize(rows, cols, radius);
+    vector<T> expected(size * batch.getGameCount());
+    for (int game = 0; game < batch.getGameCount(); game++) {
+        pair<int, int> head = batch.getHead(game);
+        encodeWithSwitch(batch.getCells(game), rows, cols, head.first, head.second, radius,
+                         expected.data() + game * size);
+    }
+
+    int mismatches = 0;
+    ObservationEncoder encoder;
+    for (KernelLevel level : {KernelLevel::SCALAR, KernelLevel::AVX2}) {
+        encoder.setKernelLevel(level);
+        vector<T> actual(expected.size(), T(7));
+        encoder.encodeBatch(batch, radius, actual.data());
+        mismatches += actual != expected;
+    }
+    return mismatches;
+}
+
+template <typename T>
+void benchmarkEncoderCase(const BatchSnakeEngine& batch, int radius, const string& label,
+                          double stepRate) {
+    const int repeats = 20;
+    int gameCount = batch.getGameCount();
+    int rows = batch.getRows();
+    int cols = batch.getCols();
+    size_t size = ObservationEncoder::observationSize(rows, cols, radius);
+    vector<T> out(size * gameCount);
+    auto timeIt = [&](const function<void()>& body) {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < repeats; i++) body();
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        return double(gameCount) * repeats / elapsed.count();
+    };
+
+    cout << "  " << label << "\n";
+    double switchRate = timeIt([&] {
+        for (int game = 0; game < gameCount; game++) {
+            pair<int, int> head = batch.getHead(game);
+            encodeWithSwitch(batch.getCells(game), rows, cols, head.first, head.second,
+                             radius, out.data() + game * size);
+        }
+    });
+    printRow("per-cell switch", switchRate, switchRate, "obs/s");
+
+    ObservationEncoder encoder;
+    for (KernelLevel level : {KernelLevel::SCALAR, KernelLevel::AVX2}) {
+        if (static_cast<int>(level) > static_cast<int>(BatchKernels::detectLevel())) continue;
+        encoder.setKernelLevel(level);
+        double rate = timeIt([&] { encoder.encodeBatch(batch, radius, out.data()); });
+        printRow("ObservationEncoder " + BatchKernels::levelName(level), rate, switchRate, "obs/s");
+    }
+    printRow("(BatchSnakeEngine::step)", stepRate, switchRate);
+}
+
+void benchmarkEncoder() {
+    cout << "\n== Observation encoding, 4096 games, 20x40 boards ==\n";
+    const int gameCount = 4096;
+    const int rows = 20;
+    const int cols = 40;
+    vector<Direction> actionTable = makeActionTable(gameCount * 7 + 13, 5);
+    vector<Direction> actions(gameCount);
+
+    // Play a while so boards hold long bodies, food and heads near edges
+    BatchSnakeEngine batch(gameCount, rows, cols, 3, 10, RIGHT);
+    batch.resetAll(3);
+    size_t cursor = 0;
+    for (int step = 0; step < 60; step++) {
+        for (int i = 0; i < gameCount; i++) actions[i] = actionTable[cursor++ % actionTable.size()];
+        batch.step(actions.data());
+    }
+
+    int mismatches = 0;
+    for (int radius : {-1, 0, 3, 7, 25}) {
+        mismatches += countEncoderMismatches<uint8_t>(batch, radius);
+        mismatches += countEncoderMismatches<float>(batch, radius);
+    }
+    cout << "  encoder mismatches vs per-cell switch: " << mismatches << "\n";
+    if (mismatches > 0) {
+        exit(1);
+    }
+
+    BatchSnakeEngine stepped(gameCount, rows, cols, 3, 10, RIGHT);
+    stepped.resetAll(3);
+    auto start = chrono::steady_clock::now();
+    for (int step = 0; step < 20; step++) {
+        for (int i = 0; i < gameCount; i++) actions[i] = actionTable[cursor++ % actionTable.size()];
+        stepped.step(actions.data());
+        for (int i = 0; i < gameCount; i++) {
+            if (stepped.isDone(i)) stepped.reset(i, i);
+        }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    double stepRate = double(gameCount) * 20 / elapsed.count();
+
+    benchmarkEncoderCase<uint8_t>(batch, -1, "whole board, uint8", stepRate);
+    benchmarkEncoderCase<float>(batch, -1, "whole board, float32", stepRate);
+    benchmarkEncoderCase<float>(batch, 5, "egocentric radius 5, float32", stepRate);
+}
+
+// ============================================
+// Suite: Random Number Generation
+// ============================================
+
+void benchmarkRandom() {
+    cout << "\n== Bounded draws for food placement ==\n";
+    cout << "  sizeof(mt19937) " << sizeof(mt19937) << " B, sizeof(Xoshiro256) "
+         << sizeof(Xoshiro256) << " B, sizeof(SnakeGameLogic) " << sizeof(SnakeGameLogic) << " B\n";
+    const long long draws = 50000000;
+
+    // Bounds shrink like the free-cell count of a filling 20x40 board
+    mt19937 twister(1);
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < draws; i++) {
+        uniform_int_distribution<int> dist(0, 799 - static_cast<int>(i % 797));
+        checksum += dist(twister);
+    }
+    chrono::duration<double> twisterElapsed = chrono::steady_clock::now() - start;
+
+    Xoshiro256 xoshiro(1);
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < draws; i++) {
+        checksum += xoshiro.nextBounded(800 - static_cast<uint32_t>(i % 797));
+    }
+    chrono::duration<double> xoshiroElapsed = chrono::steady_clock::now() - start;
+
+    double twisterRate = draws / twisterElapsed.count();
+    cout << "  (checksum " << checksum % 1000 << ")\n";
+    printRow("mt19937 + uniform_int_distribution", twisterRate, twisterRate, "draws/s");
+    printRow("Xoshiro256::nextBounded", draws / xoshiroElapsed.count(), twisterRate, "draws/s");
+}
+
+// ============================================
+// Suite: Forking for Lookahead
+// ============================================
+
+void benchmarkForking() {
+    cout << "\n== Forking a 20x40 game for 8-tick lookahead ==\n";
+    SnakeGameLogic root(5);
+    root.initializeBoard(20, 40, 15, 10, RIGHT);
+    const int forks = 200000;
+    const int depth = 8;
+    static const Direction lookahead[depth] = {UP, LEFT, LEFT, DOWN, DOWN, DOWN, RIGHT, NONE};
+    long long checksum = 0;
+
+    auto playLine = [&](SnakeGameLogic& game) {
+        for (Direction direction : lookahead) {
+            game.setDirection(direction);
+            if (!game.update()) break;
+        }
+        checksum += game.getCurrentScore() + game.getSnake().getHead().first;
+    };
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < forks; i++) {
+        auto copy = root.clone();
+        copy->setPublishing(true);
+        playLine(*copy);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    double baseline = forks / elapsed.count();
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < forks; i++) {
+        playLine(*root.clone());
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    double cloneRate = forks / elapsed.count();
+
+    SnakeGameLogic scratch(0);
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < forks; i++) {
+        root.copyStateTo(scratch);
+        playLine(scratch);
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    double copyRate = forks / elapsed.count();
+
+    root.setPublishing(false);
+    GameCheckpoint checkpoint;
+    root.saveTo(checkpoint);
+    playLine(root);                 // Warm-up: sizes the undo journals
+    root.restoreFrom(checkpoint);
+    long long allocationsBefore = heapAllocations.load();
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < forks; i++) {
+        playLine(root);
+        root.restoreFrom(checkpoint);
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    long long restoreAllocations = heapAllocations.load() - allocationsBefore;
+    root.clearCheckpoints();
+
+    cout << "  (checksum " << checksum % 1000 << ", allocations in restore loop "
+         << restoreAllocations << ")\n";
+    printRow("clone(), publishing each tick", baseline, baseline, "forks/s");
+    printRow("clone(), no publishing", cloneRate, baseline, "forks/s");
+    printRow("copyStateTo() into scratch game", copyRate, baseline, "forks/s");
+    printRow("saveTo() / restoreFrom()", forks / elapsed.count(), baseline, "forks/s");
+}
+
+// ============================================
+// Suite: BFS Autopilot
+// ============================================
+
+void benchmarkBfs() {
+    cout << "\n== BFS autopilot decisions on a 200x200 board ==\n";
+    const long long maxTicks = 100000;
+    SnakeGameLogic game(1);
+    game.initializeBoard(200, 200, 3, 10, RIGHT);
+    game.setPublishing(false);
+    BfsAutopilot autopilot;
+    autopilot.decide(game);         // Sizes the search buffers
+
+    long long ticks = 0;
+    long long visited = 0;
+    long long allocationsBefore = heapAllocations.load();
+    auto start = chrono::steady_clock::now();
+    while (ticks < maxTicks && !game.hasEnded()) {
+        game.setDirection(autopilot.decide(game));
+        visited += autopilot.getLastVisited();
+        game.update();
+        ticks++;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    long long allocations = heapAllocations.load() - allocationsBefore;
+
+    double rate = ticks / elapsed.count();
+    cout << "  " << ticks << " ticks, score " << game.getCurrentScore() << ", "
+         << visited / max(ticks, 1LL) << " cells searched per decision, "
+         << allocations << " allocations\n";
+    cout << "  " << fixed << setprecision(1) << 1e6 / rate << " us per decision + tick\n";
+    printRow("decide() + update()", rate, rate, "ticks/s");
+}
+
+// ============================================
+// Suite: Full-Board Endgame
+// ============================================
+
+/**
+ * @brief Replays a recorded game, timing update() separately in each fill band.
+ * @param bandTicks Ticks spent in each band, filled in
+ * @param bandSeconds Seconds spent in update() in each band, filled in
+ */
+void replayEndgame(SnakeGameLogic& game, const vector<Direction>& moves, int rows, int cols,
+                   const int* bandEnds, int bandCount, long long* bandTicks, double* bandSeconds) {
+    game.initializeBoard(rows, cols, 3, 10, RIGHT);
+    size_t move = 0;
+    for (int band = 0; band < bandCount; band++) {
+        long long bandEnd = static_cast<long long>(bandEnds[band]) * rows * cols;
+        auto start = chrono::steady_clock::now();
+        long long ticks = 0;
+        while (move < moves.size() && static_cast<long long>(game.getSnake().getLength()) * 100 < bandEnd) {
+            game.setDirection(moves[move++]);
+            game.update();
+            ticks++;
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        bandTicks[band] = ticks;
+        bandSeconds[band] = elapsed.count();
+    }
+}
+
+void benchmarkEndgame() {
+    cout << "\n== Full-board endgame (Hamiltonian cycle autopilot) ==\n";
+    const int rows = 32;
+    const int cols = 32;
+
+    auto buildStart = chrono::steady_clock::now();
+    HamiltonCycle::forBoard(rows, cols);
+    chrono::duration<double> built = chrono::steady_clock::now() - buildStart;
+    auto cachedStart = chrono::steady_clock::now();
+    HamiltonCycle::forBoard(rows, cols);
+    chrono::duration<double> cached = chrono::steady_clock::now() - cachedStart;
+    cout << "  Cycle tables for " << rows << "x" << cols << ": " << fixed << setprecision(1)
+         << built.count() * 1e6 << " us to build, " << cached.count() * 1e6 << " us cached\n";
+
+    // Play once to record the moves, then replay them with only update() timed
+    SnakeGameLogic recorder(7);
+    recorder.initializeBoard(rows, cols, 3, 10, RIGHT);
+    recorder.setPublishing(false);
+    HamiltonAutopilot autopilot;
+    vector<Direction> moves;
+    while (!recorder.hasEnded()) {
+        moves.push_back(autopilot.decide(recorder));
+        recorder.setDirection(moves.back());
+        recorder.update();
+    }
+    cout << "  " << moves.size() << " ticks, "
+         << (recorder.getGameOverReason() == BOARD_FULL ? "board cleared" : "snake died")
+         << ", length " << recorder.getSnake().getLength() << " of " << rows * cols << "\n";
+
+    const int bandEnds[] = {50, 90, 99, 101};
+    const char* bandNames[] = {"length < 50%", "50% - 90%", "90% - 99%", ">= 99%"};
+    const int bandCount = 4;
+    const char* modes[] = {"no publishing", "delta publishing", "full publishing"};
+    for (int mode = 0; mode < 3; mode++) {
+        SnakeGameLogic game(7);
+        game.setPublishing(mode > 0);
+        game.setDeltaPublishing(mode == 1);
+        long long bandTicks[bandCount];
+        double bandSeconds[bandCount];
+        replayEndgame(game, moves, rows, cols, bandEnds, bandCount, bandTicks, bandSeconds);
+
+        cout << "\n  update(), " << modes[mode] << "\n";
+        double baseline = bandTicks[0] / bandSeconds[0];
+        for (int band = 0; band < bandCount; band++) {
+            printRow(bandNames[band], bandTicks[band] / max(bandSeconds[band], 1e-9), baseline);
+        }
+    }
+}
+
+// ============================================
+// Suite: Bit-Parallel Flood Fill
+// ============================================
+
+/**
+ * @brief Per-cell BFS reference for FloodFill::evaluateMoves(), with
+ *        generation-stamped visits and a flat frontier like BfsAutopilot.
+ */
+class CellBfsSpace {
+private:
+    vector<uint32_t> stamp;
+    vector<int32_t> frontier;
+    uint32_t generation = 0;
+
+public:
+    int evaluateMoves(const SnakeGameLogic& game, MoveSpace* out) {
+        const Board& board = game.getBoard();
+        const uint8_t* cells = board.getCells().data();
+        int rows = board.getRows();
+        int cols = board.getCols();
+        stamp.resize(rows * cols);
+        frontier.resize(rows * cols);
+        const Snake& snake = game.getSnake();
+        const SnakeBody& body = snake.getBody();
+        pair<int, int> head = snake.getHead();
+        pair<int, int> tail = body.back();
+        int tailIndex = tail.first * cols + tail.second;
+        int length = static_cast<int>(body.size());
+        Direction reverse = MoveHelper::opposite(game.getCurrentDirection());
+
+        int count = 0;
+        for (int d = 0; d < 4; d++) {
+            Direction dir = static_cast<Direction>(d);
+            if (dir == reverse) continue;
+            MoveSpace& space = out[count++];
+            space = {dir, MoveHelper::isSafe(game, dir), 0, false};
+            if (!space.legal) continue;
+
+            pair<int, int> target = {head.first + MoveHelper::rowDelta[d],
+                                     head.second + MoveHelper::colDelta[d]};
+            const FoodManager& food = game.getFoodManager();
+            bool grows = snake.hasPendingGrowth() || (food.isPresent() && food.getPosition() == target);
+            generation++;
+            int start = target.first * cols + target.second;
+            stamp[start] = generation;
+            frontier[0] = start;
+            int queueHead = 0;
+            int queueTail = 1;
+            while (queueHead < queueTail) {
+                int cell = frontier[queueHead++];
+                int r = cell / cols;
+                int c = cell % cols;
+                for (int e = 0; e < 4; e++) {
+                    int nr = r + MoveHelper::rowDelta[e];
+                    int nc = c + MoveHelper::colDelta[e];
+                    if (nr < 0 || nr >= rows || nc < 0 || nc >= cols) continue;
+                    int next = nr * cols + nc;
+                    bool open = !(cells[next] & 1) || (!grows && next == tailIndex);
+                    if (!open || stamp[next] == generation) continue;
+                    stamp[next] = generation;
+                    frontier[queueTail++] = next;
+                }
+            }
+            space.area = queueTail - 1;
+
+            pair<int, int> nextTail = grows || length < 2 ? tail : body[length - 2];
+            space.tailReachable = length < 2;
+            for (int e = -1; e < 4; e++) {
+                int nr = nextTail.first + (e < 0 ? 0 : MoveHelper::rowDelta[e]);
+                int nc = nextTail.second + (e < 0 ? 0 : MoveHelper::colDelta[e]);
+                if (nr >= 0 && nr < rows && nc >= 0 && nc < cols && stamp[nr * cols + nc] == generation) {
+                    space.tailReachable = true;
+                }
+            }
+        }
+        return count;
+    }
+};
+
+template <typename Evaluator>
+double measureMoveSpaces(Evaluator& evaluator, const SnakeGameLogic& game, int repeats,
+                         long long& checksum) {
+    MoveSpace spaces[4];
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++) {
+        int count = evaluator.evaluateMoves(game, spaces);
+        for (int m = 0; m < count; m++) checksum += spaces[m].area + spaces[m].tailReachable;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return repeats / elapsed.count();
+}
+
+void benchmarkFloodFill() {
+    cout << "\n== Reachable space after each move: bit-parallel vs per-cell BFS ==\n";
+    const int repeats = 2000;
+    const int sizes[][2] = {{64, 64}, {64, 200}};
+    const long long stopTicks[] = {0, 2000, 8000};
+
+    for (auto& size : sizes) {
+        SnakeGameLogic game(3);
+        game.initializeBoard(size[0], size[1], 3, 10, RIGHT);
+        game.setPublishing(false);
+        BfsAutopilot autopilot;
+        long long ticks = 0;
+        for (long long stop : stopTicks) {
+            while (ticks < stop && !game.hasEnded()) {
+                game.setDirection(autopilot.decide(game));
+                game.update();
+                ticks++;
+            }
+            if (game.hasEnded()) break;
+
+            FloodFill flood;
+            CellBfsSpace bfs;
+            long long floodSum = 0;
+            long long bfsSum = 0;
+            double bfsRate = measureMoveSpaces(bfs, game, repeats, bfsSum);
+            double floodRate = measureMoveSpaces(flood, game, repeats, floodSum);
+
+            cout << "\n  Board " << size[0] << "x" << size[1] << ", snake length "
+                 << game.getSnake().getLength()
+                 << (floodSum == bfsSum ? "" : " (RESULTS DIFFER)") << "\n";
+            printRow("per-cell BFS, 3 moves", bfsRate, bfsRate, "evals/s");
+            printRow("FloodFill, 3 moves", floodRate, bfsRate, "evals/s");
+        }
+    }
+}
+
+// ============================================
+// Suite: Incremental Distance Field
+// ============================================
+
+/**
+ * @brief Steps to the safe neighbor of the head closest to the food.
+ */
+Direction descendField(const SnakeGameLogic& game, const DistanceField& field) {
+    pair<int, int> head = game.getSnake().getHead();
+    Direction best = game.getCurrentDirection();
+    int32_t bestDistance = INT32_MAX;
+    bool bestSafe = false;
+    for (int d = 0; d < 4; d++) {
+        Direction dir = static_cast<Direction>(d);
+        if (!MoveHelper::isSafe(game, dir)) continue;
+        int32_t distance = field.getDistance(head.first + MoveHelper::rowDelta[d],
+                                             head.second + MoveHelper::colDelta[d]);
+        if (!bestSafe || distance < bestDistance) {
+            best = dir;
+            bestDistance = distance;
+            bestSafe = true;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Plays a game steered by the field, keeping it current each tick.
+ * @param incremental True to refresh() from board changes, false to recompute()
+ * @return Seconds spent updating the field
+ */
+double playDistanceField(int rows, int cols, long long maxTicks, bool incremental,
+                         long long& ticks, long long& checksum, DistanceField& field) {
+    SnakeGameLogic game(1);
+    game.initializeBoard(rows, cols, 3, 10, RIGHT);
+    game.setPublishing(false);
+    if (incremental) field.attach(game);
+    field.recompute(game.getBoard());
+
+    double seconds = 0;
+    ticks = 0;
+    checksum = 0;
+    while (ticks < maxTicks && !game.hasEnded()) {
+        game.setDirection(descendField(game, field));
+        game.update();
+        ticks++;
+        auto start = chrono::steady_clock::now();
+        if (incremental) {
+            field.refresh(game.getBoard());
+        } else {
+            field.recompute(game.getBoard());
+        }
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (!game.hasEnded()) {
+            pair<int, int> head = game.getSnake().getHead();
+            checksum += field.getDistance(head.first, head.second);
+        }
+    }
+    if (incremental) field.detach(game);
+    return seconds;
+}
+
+void benchmarkDistanceField() {
+    cout << "\n== Distance to food: incremental repair vs full recompute per tick ==\n";
+    const int sizes[][3] = {{200, 200, 20000}, {500, 500, 4000}, {1000, 1000, 600}};
+
+    for (auto& size : sizes) {
+        DistanceField incremental;
+        DistanceField full;
+        long long ticks = 0;
+        long long fullTicks = 0;
+        long long checksum = 0;
+        long long fullChecksum = 0;
+        double incrementalSeconds = playDistanceField(size[0], size[1], size[2], true,
+                                                      ticks, checksum, incremental);
+        double fullSeconds = playDistanceField(size[0], size[1], size[2], false,
+                                               fullTicks, fullChecksum, full);
+        bool same = ticks == fullTicks && checksum == fullChecksum;
+
+        double fullRate = fullTicks / fullSeconds;
+        double incrementalRate = ticks / incrementalSeconds;
+        cout << "\n  Board " << size[0] << "x" << size[1] << ", " << ticks << " ticks, "
+             << incremental.getRebuildCount() << " full rebuilds, "
+             << incremental.getRepairedCells() / max(ticks, 1LL) << " cells repaired per tick"
+             << (same ? "" : " (RESULTS DIFFER)") << "\n";
+        cout << "  " << fixed << setprecision(1) << 1e6 / fullRate << " us vs "
+             << 1e6 / incrementalRate << " us per tick\n";
+        printRow("recompute() every tick", fullRate, fullRate, "ticks/s");
+        printRow("refresh() every tick", incrementalRate, fullRate, "ticks/s");
+    }
+}
+
+// ============================================
+// Suite: Parallel MCTS
+// ============================================
+
+void benchmarkMcts() {
+    int cores = max(1, static_cast<int>(thread::hardware_concurrency()));
+    cout << "\n== MCTS autopilot, 20 ms per decision, 20x40, "
+         << cores << " hardware thread(s) ==\n";
+    const int decisions = 50;
+    double baseline = 0;
+    for (int threads = 1; ; threads = min(threads * 2, cores)) {
+        MctsConfig config = MctsConfig::forUpdateDelay(30);
+        config.threads = threads;
+        MctsAutopilot autopilot(config);
+        SnakeGameLogic game(9);
+        game.initializeBoard(20, 40, 3, 10, RIGHT);
+        long long iterations = 0;
+        double worstMs = 0;
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < decisions && !game.hasEnded(); i++) {
+            auto decisionStart = chrono::steady_clock::now();
+            game.setDirection(autopilot.decide(game));
+            chrono::duration<double, milli> decisionTime = chrono::steady_clock::now() - decisionStart;
+            worstMs = max(worstMs, decisionTime.count());
+            iterations += autopilot.getLastIterations();
+            game.update();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        double rate = iterations / elapsed.count();
+        if (baseline == 0) baseline = rate;
+        ostringstream label;
+        label << threads << " thread(s), worst " << fixed << setprecision(1) << worstMs << " ms";
+        printRow(label.str(), rate, baseline, "rollouts/s");
+        if (threads == cores) break;
+    }
+}
+
+// ============================================
+// Suite: Double-Buffered Pipeline
+// ============================================
+
+/**
+ * @brief Stand-in for policy inference: a linear layer with four outputs
+ *        over each observation, then argmax.
+ */
+class LinearPolicy {
+private:
+    vector<float> weights;
+    size_t inputSize;
+
+public:
+    explicit LinearPolicy(size_t inputSize) : weights(4 * inputSize), inputSize(inputSize) {
+        Xoshiro256 rng(3);
+        for (float& weight : weights) weight = static_cast<float>(rng.nextBounded(1000)) / 1000.0f - 0.5f;
+    }
+
+    void infer(const float* observations, int count, int32_t* actions) const {
+        for (int game = 0; game < count; game++) {
+            const float* input = observations + game * inputSize;
+            int best = 0;
+            float bestLogit = 0;
+            for (int action = 0; action < 4; action++) {
+                const float* row = weights.data() + action * inputSize;
+                float logit = 0;
+                for (size_t i = 0; i < inputSize; i++) logit += row[i] * input[i];
+                if (action == 0 || logit > bestLogit) {
+                    best = action;
+                    bestLogit = logit;
+                }
+            }
+            actions[game] = best;
+        }
+    }
+};
+
+void benchmarkPipeline() {
+    int cores = max(1, static_cast<int>(thread::hardware_concurrency()));
+    cout << "\n== Auto-reset pipeline, 2 x 1024 games, 20x40, linear policy, "
+         << cores << " hardware thread(s) ==\n";
+    const int games = 1024;
+    const int rounds = 400;
+    const int radius = 5;
+
+    // Serialized: inference, then step, then encode, on one thread
+    BatchSnakeEngine engine(games, 20, 40, 3, 1, RIGHT);
+    engine.resetAll(11);
+    engine.setAutoReset(true, 11);
+    ObservationEncoder encoder;
+    LinearPolicy policy(ObservationEncoder::observationSize(20, 40, radius));
+    vector<float> observations(games * ObservationEncoder::observationSize(20, 40, radius));
+    vector<int32_t> choices(games);
+    vector<Direction> actions(games);
+    encoder.encodeBatch(engine, radius, observations.data());
+    auto start = chrono::steady_clock::now();
+    for (int round = 0; round < 2 * rounds; round++) {
+        policy.infer(observations.data(), games, choices.data());
+        for (int game = 0; game < games; game++) actions[game] = static_cast<Direction>(choices[game]);
+        engine.step(actions.data());
+        encoder.encodeBatch(engine, radius, observations.data());
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    double baseline = 2.0 * rounds * games / elapsed.count();
+    printRow("serialized step + inference", baseline, baseline, "steps/s");
+
+    // Pipelined: one batch steps on the pool while the caller infers on the other
+    for (int threads = 1; ; threads = min(threads * 2, cores)) {
+        BatchPipeline pipeline(games, 20, 40, radius, threads, 11);
+        start = chrono::steady_clock::now();
+        for (int round = 0; round < 2 * rounds; round++) {
+            PipelineBatch& batch = pipeline.acquire();
+            policy.infer(batch.observations.data(), games, batch.actions.data());
+            pipeline.submit(batch);
+        }
+        pipeline.acquire();
+        pipeline.acquire();
+        elapsed = chrono::steady_clock::now() - start;
+        printRow("pipelined, " + to_string(threads) + " stepping thread(s)",
+                 2.0 * rounds * games / elapsed.count(), baseline, "steps/s");
+        if (threads == cores) break;
+    }
+}
+
+// ============================================
+// Main Entry Point
+// ============================================
+
+int main(int argc, char** argv) {
+    vector<pair<string, function<void()>>> suites = {
+        {"bitboard", benchmarkBitboard},
+        {"fixed", benchmarkFixedDimensions},
+        {"delta", benchmarkDeltaPublishing},
+        {"publisher", benchmarkPublisher},
+        {"allocations", benchmarkAllocations},
+        {"history", benchmarkHistory},
+        {"batch", benchmarkBatch},
+        {"kernels", benchmarkKernels},
+        {"rollouts", benchmarkRollouts},
+        {"encoder", benchmarkEncoder},
+        {"rng", benchmarkRandom},
+        {"pipeline", benchmarkPipeline},
+        {"forking", benchmarkForking},
+        {"mcts", benchmarkMcts},
+        {"bfs", benchmarkBfs},
+        {"endgame", benchmarkEndgame},
+        {"flood", benchmarkFloodFill},
+        {"distance", benchmarkDistanceField},
+    };
+
+    string selected = argc > 1 ? argv[1] : "";
+    for (auto& suite : suites) {
+        if (selected.empty() || selected == suite.first) {
+            suite.second();
+        }
+    }
+    return 0;
+}
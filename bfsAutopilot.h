@@ -0,0 +1,240 @@
+// bfsAutopilot.h
+#ifndef BFSAUTOPILOT_H
+#define BFSAUTOPILOT_H
+
+#include "autopilot.h"
+#include "floodFill.h"
+
+// ============================================================================
+// BREADTH-FIRST SEARCH AUTOPILOT
+// ============================================================================
+
+/**
+ * @brief Follows a shortest path to the food, found by breadth-first search.
+ *
+ * The search is tail-aware: body segment i (head = 0) of a snake of length
+ * L leaves its cell after L - i ticks (one more while growth is pending),
+ * so a path may run through that cell if the head gets there no sooner.
+ * A path whose first step walls the head into a pocket smaller than the
+ * snake, with no way back to the tail, is retried without that first
+ * step. When the food is unreachable, or only through such pockets, the
+ * snake follows a shortest path to its own tail instead, and failing that
+ * takes the move with the most room. Chasing the tail repeats the same
+ * position once the body has come round, so after patienceTicks() of it
+ * the pocket check is waived and the snake goes for the food.
+ *
+ * Every buffer (frontier, per-cell parents, body timings) is sized once
+ * per board size. Visited cells carry the number of the search that
+ * reached them, so starting a search only increments a counter instead of
+ * clearing the board-sized visited array.
+ */
+class BfsAutopilot : public Autopilot {
+private:
+    /**
+     * @brief Per-cell search state, kept together so a visit touches one line.
+     */
+    struct SearchCell {
+        uint32_t stamp;             ///< Search generation that last reached the cell
+        int32_t parent;             ///< Previous cell on the path, valid when stamped
+    };
+
+    vector<SearchCell> searchCells;
+    vector<int32_t> freeAt;         ///< Tick at which each body cell is vacated
+    vector<int32_t> frontier;       ///< BFS queue of flat cell indices
+    vector<int32_t> frontierCol;    ///< Column of each queued cell, to avoid dividing
+    FloodFill floodFill;
+    uint32_t generation;
+    int lastVisited;
+    int hungryTicks;                ///< Decisions since the snake last grew
+    int lastLength;                 ///< Snake length at the previous decision
+
+    void prepare(int cellCount) {
+        if (static_cast<int>(searchCells.size()) != cellCount) {
+            searchCells.assign(cellCount, {0, -1});
+            freeAt.resize(cellCount);
+            frontier.resize(cellCount);
+            frontierCol.resize(cellCount);
+            generation = 0;
+        }
+    }
+
+    /**
+     * @brief Records when each body cell is vacated.
+     *
+     * Skips segments off the board, which Snake::initialize() leaves when
+     * the starting length does not fit beside the centered head.
+     */
+    void markBody(const SnakeGameLogic& game) {
+        const Snake& snake = game.getSnake();
+        const SnakeBody& body = snake.getBody();
+        const Board& board = game.getBoard();
+        int length = static_cast<int>(body.size());
+        int delay = snake.hasPendingGrowth() ? 1 : 0;
+        for (int i = 0; i < length; i++) {
+            pair<int, int> segment = body[i];
+            if (!board.isInBounds(segment.first, segment.second)) continue;
+            freeAt[board.indexOf(segment.first, segment.second)] = length - i + delay;
+        }
+    }
+
+    /**
+     * @brief Runs one BFS from the head.
+     * @param target Flat index to reach
+     * @param blockedFirst Bit per Direction the first step may not take
+     * @return Flat index of the first step towards target, or -1 if unreachable
+     */
+    int search(const SnakeGameLogic& game, int head, int headCol, int target, int blockedFirst = 0) {
+        const Board& board = game.getBoard();
+        const uint8_t* cells = board.getCells().data();
+        int cols = board.getCols();
+        int cellCount = board.getRows() * cols;
+        Direction reverse = MoveHelper::opposite(game.getCurrentDirection());
+
+        if (++generation == 0) {
+            fill(searchCells.begin(), searchCells.end(), SearchCell{0, -1});
+            generation = 1;
+        }
+        searchCells[head].stamp = generation;
+        frontier[0] = head;
+        frontierCol[0] = headCol;
+        int queueHead = 0;
+        int queueTail = 1;
+        int layerEnd = 1;           // Cells before layerEnd are reached at tick - 1
+        int tick = 1;
+        bool found = false;
+
+        while (queueHead < queueTail && !found) {
+            if (queueHead == layerEnd) {
+                layerEnd = queueTail;
+                tick++;
+            }
+            int cell = frontier[queueHead];
+            int col = frontierCol[queueHead++];
+
+            // Neighbors in UP, DOWN, LEFT, RIGHT order; -1 where off the board
+            int next[4] = {cell >= cols ? cell - cols : -1,
+                           cell + cols < cellCount ? cell + cols : -1,
+                           col > 0 ? cell - 1 : -1,
+                           col + 1 < cols ? cell + 1 : -1};
+            if (cell == head) {
+                if (reverse != NONE) next[reverse] = -1;
+                for (int d = 0; d < 4; d++) {
+                    if (blockedFirst & (1 << d)) next[d] = -1;
+                }
+            }
+            for (int d = 0; d < 4; d++) {
+                int neighbor = next[d];
+                if (neighbor < 0 || searchCells[neighbor].stamp == generation) continue;
+                uint8_t type = cells[neighbor];
+                if (type == WALL || (type == SNAKE && freeAt[neighbor] > tick)) continue;
+                searchCells[neighbor] = {generation, cell};
+                frontier[queueTail] = neighbor;
+                frontierCol[queueTail++] = col + MoveHelper::colDelta[d];
+                if (neighbor == target) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+        lastVisited = queueTail;
+        if (!found) return -1;
+
+        int step = target;
+        while (searchCells[step].parent != head) step = searchCells[step].parent;
+        return step;
+    }
+
+    static Direction directionTo(int from, int to, int cols) {
+        if (to == from - cols) return UP;
+        if (to == from + cols) return DOWN;
+        return to == from - 1 ? LEFT : RIGHT;
+    }
+
+    /**
+     * @brief Checks whether a move shuts the head into a pocket smaller than
+     *        the snake with no way back to the tail.
+     */
+    static bool isPocket(const MoveSpace* spaces, int count, Direction dir, int length) {
+        for (int m = 0; m < count; m++) {
+            if (spaces[m].direction == dir) return !spaces[m].tailReachable && spaces[m].area < length;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gets how long to chase the tail before waiving the pocket check:
+     *        one lap of the body plus the time to cross the board.
+     */
+    static int patienceTicks(const SnakeGameLogic& game) {
+        const Board& board = game.getBoard();
+        return static_cast<int>(game.getSnake().getLength()) + board.getRows() + board.getCols();
+    }
+
+public:
+    BfsAutopilot() : generation(0), lastVisited(0), hungryTicks(0), lastLength(0) {}
+
+    Direction decide(const SnakeGameLogic& game) override {
+        const Board& board = game.getBoard();
+        const Snake& snake = game.getSnake();
+        int cols = board.getCols();
+        prepare(board.getRows() * cols);
+        markBody(game);
+
+        pair<int, int> headPos = snake.getHead();
+        int head = board.indexOf(headPos.first, headPos.second);
+        int step = -1;
+        const FoodManager& food = game.getFoodManager();
+        MoveSpace spaces[4];
+        int count = floodFill.evaluateMoves(game, spaces);
+        int length = static_cast<int>(snake.getLength());
+        hungryTicks = length == lastLength ? hungryTicks + 1 : 0;
+        lastLength = length;
+        if (food.isPresent()) {
+            pair<int, int> foodPos = food.getPosition();
+            int target = board.indexOf(foodPos.first, foodPos.second);
+            bool patient = hungryTicks < patienceTicks(game);
+            // Retry without any first step that walls the head into a pocket
+            int blocked = 0;
+            for (int attempt = 0; attempt < 4; attempt++) {
+                step = search(game, head, headPos.second, target, blocked);
+                if (step < 0 || !patient) break;
+                Direction dir = directionTo(head, step, cols);
+                if (!isPocket(spaces, count, dir, length)) break;
+                blocked |= 1 << dir;
+                step = -1;
+            }
+        }
+        pair<int, int> tailPos = snake.getBody().back();
+        if (step < 0 && snake.getLength() > 1 && board.isInBounds(tailPos.first, tailPos.second)) {
+            step = search(game, head, headPos.second, board.indexOf(tailPos.first, tailPos.second));
+        }
+        if (step >= 0) return directionTo(head, step, cols);
+
+        // No path: take the move that keeps the most room, preferring the tail
+        Direction best = game.getCurrentDirection();
+        int bestScore = -1;
+        for (int m = 0; m < count; m++) {
+            if (!spaces[m].legal) continue;
+            int score = spaces[m].area + (spaces[m].tailReachable ? board.getRows() * cols : 0);
+            if (score > bestScore) {
+                bestScore = score;
+                best = spaces[m].direction;
+            }
+        }
+        return best;
+    }
+
+    void reset() override {
+        hungryTicks = 0;
+        lastLength = 0;
+    }
+
+    string getName() const override { return "bfs"; }
+
+    /**
+     * @brief Gets how many cells the last search reached.
+     */
+    int getLastVisited() const { return lastVisited; }
+};
+
+#endif // BFSAUTOPILOT_H
@@ -0,0 +1,413 @@
+// bitboardLogic.h
+#ifndef BITBOARDLOGIC_H
+#define BITBOARDLOGIC_H
+
+#include "gameLogic.h"
+#include <bit>
+
+// ============================================================================
+// BIT PLANE
+// ============================================================================
+
+/**
+ * @brief One bit per board cell, packed row-major into 64-bit words.
+ *
+ * Bit i of the plane corresponds to flat cell index i (r * cols + c).
+ * Bits past the last cell are always zero.
+ */
+class BitPlane {
+private:
+    vector<uint64_t> words;
+
+public:
+    void reset(int cellCount) {
+        words.assign((cellCount + 63) / 64, 0);
+    }
+
+    bool test(int index) const {
+        return (words[index >> 6] >> (index & 63)) & 1;
+    }
+
+    void set(int index) {
+        words[index >> 6] |= uint64_t(1) << (index & 63);
+    }
+
+    void clear(int index) {
+        words[index >> 6] &= ~(uint64_t(1) << (index & 63));
+    }
+
+    void assign(int index, bool value) {
+        if (value) set(index); else clear(index);
+    }
+
+    uint64_t word(int w) const { return words[w]; }
+    int wordCount() const { return static_cast<int>(words.size()); }
+    size_t memoryBytes() const { return words.size() * sizeof(uint64_t); }
+};
+
+// ============================================================================
+// BITBOARD GAME ENGINE
+// ============================================================================
+
+/**
+ * @brief Alternative game engine storing the board as bit planes.
+ *
+ * Snake, food and wall occupancy are one bit per cell each. The body order
+ * is kept in two more planes holding, for every segment, the direction
+ * towards the next segment nearer the head, so the tail can follow the body
+ * without a separate segment list. Occupancy tests, empty-cell counting and
+ * random empty-cell selection work a 64-bit word at a time.
+ *
+ * Follows the same rules and exposes the same initializeBoard(), update()
+ * and setDirection() surface as SnakeGameLogic so the two can be swapped or
+ * stepped side by side. State is read directly on the game thread; there is
+ * no snapshot publishing.
+ */
+class BitboardSnakeGame {
+private:
+    BitPlane snakeBits;
+    BitPlane foodBits;
+    BitPlane wallBits;
+    BitPlane linkLow;               ///< Low bit of the direction to the next segment
+    BitPlane linkHigh;              ///< High bit of the direction to the next segment
+    DirectionController directionController;
+
+    Xoshiro256 rng;
+    int rows;
+    int cols;
+    int cellCount;
+    int headIndex;
+    int tailIndex;
+    int length;
+    int offBoardSegments;          ///< Starting segments past the board edge, behind the tail
+    int growthPending;
+    int foodIndex;
+    bool foodExists;
+    int score;
+    int pointsPerFood;
+    bool gameOver;
+
+    /**
+     * @brief Gets the mask of cells that are neither snake, food nor wall.
+     * @param w Word index
+     * @return Word with one bit per empty cell
+     */
+    uint64_t emptyWord(int w) const {
+        uint64_t occupied = snakeBits.word(w) | foodBits.word(w) | wallBits.word(w);
+        uint64_t valid = ~uint64_t(0);
+        int remaining = cellCount - w * 64;
+        if (remaining < 64) valid = (uint64_t(1) << remaining) - 1;
+        return ~occupied & valid;
+    }
+
+    /**
+     * @brief Finds the position of the nth set bit of a word.
+     * @param word Word to search
+     * @param n Zero-based rank of the set bit
+     * @return Bit position
+     */
+    static int selectBit(uint64_t word, int n) {
+        int base = 0;
+        for (int shift = 32; shift >= 8; shift >>= 1) {
+            uint64_t lowMask = (uint64_t(1) << shift) - 1;
+            int lowCount = popcount(word & lowMask);
+            if (n >= lowCount) {
+                n -= lowCount;
+                word >>= shift;
+                base += shift;
+            }
+        }
+        for (; n > 0; n--) {
+            word &= word - 1;
+        }
+        return base + countr_zero(word);
+    }
+
+    Direction getLink(int index) const {
+        return static_cast<Direction>((linkHigh.test(index) << 1) | linkLow.test(index));
+    }
+
+    void setLink(int index, Direction dir) {
+        linkLow.assign(index, dir & 1);
+        linkHigh.assign(index, dir & 2);
+    }
+
+    int step(int index, Direction dir) const {
+        switch (dir) {
+            case UP:    return index - cols;
+            case DOWN:  return index + cols;
+            case LEFT:  return index - 1;
+            case RIGHT: return index + 1;
+            case NONE:  break;
+        }
+        return index;
+    }
+
+    void placeRandomFood() {
+        int emptyCount = countEmptyCells();
+        if (emptyCount == 0) {
+            foodExists = false;
+            return;
+        }
+
+        foodIndex = findNthEmpty(static_cast<int>(rng.nextBounded(emptyCount)));
+        foodBits.set(foodIndex);
+        foodExists = true;
+    }
+
+public:
+    BitboardSnakeGame()
+        : rows(0), cols(0), cellCount(0), headIndex(0), tailIndex(0), length(0),
+          offBoardSegments(0), growthPending(0), foodIndex(0), foodExists(false), score(0),
+          pointsPerFood(10), gameOver(false) {
+        auto seed = chrono::high_resolution_clock::now().time_since_epoch().count();
+        rng.seed(static_cast<uint64_t>(seed));
+    }
+
+    /**
+     * @brief Reseeds food placement; takes effect from the next placement.
+     * @param seed Seed for food placement
+     * @param stream Stream index, e.g. the game's index in a parallel batch
+     */
+    void setSeed(uint64_t seed, uint64_t stream = 0) {
+        rng.seed(seed, stream);
+    }
+
+    /**
+     * @brief Initializes the game with specified parameters.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param startingLength Initial snake length
+     * @param pointsPerFood Points awarded per food
+     * @param initialDirection Starting movement direction
+     */
+    void initializeBoard(int rows, int cols, int startingLength,
+                        int pointsPerFood, Direction initialDirection) {
+        this->rows = rows;
+        this->cols = cols;
+        this->pointsPerFood = pointsPerFood;
+        cellCount = rows * cols;
+        score = 0;
+        gameOver = false;
+        growthPending = 0;
+
+        snakeBits.reset(cellCount);
+        foodBits.reset(cellCount);
+        wallBits.reset(cellCount);
+        linkLow.reset(cellCount);
+        linkHigh.reset(cellCount);
+        directionController.initialize(initialDirection);
+
+        // Lay the body out behind the head exactly as Snake::initialize does.
+        // Segments past the edge have no cell; they only count towards the
+        // length and are dropped, one per tick, before the tail moves.
+        pair<int, int> segment = {rows / 2, cols / 2};
+        headIndex = segment.first * cols + segment.second;
+        tailIndex = headIndex;
+        length = startingLength;
+        offBoardSegments = 0;
+        for (int i = 0; i < startingLength; i++) {
+            if (segment.first < 0 || segment.first >= rows ||
+                segment.second < 0 || segment.second >= cols) {
+                offBoardSegments = startingLength - i;
+                break;
+            }
+            tailIndex = segment.first * cols + segment.second;
+            snakeBits.set(tailIndex);
+            setLink(tailIndex, initialDirection);
+
+            switch (initialDirection) {
+                case RIGHT: segment.second--; break;
+                case LEFT:  segment.second++; break;
+                case UP:    segment.first++; break;
+                case DOWN:  segment.first--; break;
+                case NONE:  break;
+            }
+        }
+
+        placeRandomFood();
+    }
+
+    /**
+     * @brief Sets the snake direction (thread-safe input).
+     * @param newDir Direction to move
+     */
+    void setDirection(Direction newDir) {
+        directionController.setInput(newDir);
+    }
+
+    /**
+     * @brief Updates the game state by one tick.
+     * @return True if game continues, false if game over
+     */
+    bool update() {
+        if (gameOver) {
+            return false;
+        }
+
+        directionController.processInput();
+        Direction dir = directionController.getCurrent();
+        pair<int, int> newHead = directionController.getNextPosition(getHead());
+
+        if (newHead.first < 0 || newHead.first >= rows ||
+            newHead.second < 0 || newHead.second >= cols) {
+            gameOver = true;
+            return false;
+        }
+
+        int newIndex = newHead.first * cols + newHead.second;
+        if (wallBits.test(newIndex) || isSelfCollision(newIndex)) {
+            gameOver = true;
+            return false;
+        }
+
+        if (foodExists && newIndex == foodIndex) {
+            growthPending++;
+            score += pointsPerFood;
+            foodBits.clear(foodIndex);
+            foodExists = false;
+        }
+
+        // Link the old head first so a length-1 tail knows where to go
+        setLink(headIndex, dir);
+        if (growthPending > 0) {
+            growthPending--;
+            length++;
+        } else if (offBoardSegments > 0) {
+            offBoardSegments--;
+        } else {
+            snakeBits.clear(tailIndex);
+            tailIndex = step(tailIndex, getLink(tailIndex));
+        }
+        snakeBits.set(newIndex);
+        headIndex = newIndex;
+
+        if (!foodExists) {
+            placeRandomFood();
+        }
+
+        if (!foodExists && growthPending == 0) {
+            gameOver = true;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks if moving the head into a cell hits the body.
+     *
+     * The tail cell is free when the snake is not growing and no segments
+     * remain off the board, matching Snake::checkSelfCollision().
+     * @param index Flat cell index of the new head
+     * @return True if collision detected, false otherwise
+     */
+    bool isSelfCollision(int index) const {
+        if (!snakeBits.test(index)) return false;
+        return growthPending > 0 || offBoardSegments > 0 || index != tailIndex;
+    }
+
+    /**
+     * @brief Computes which absolute directions are safe next moves.
+     * @return Bit mask with bit d set when moving in Direction d survives
+     */
+    int legalMoveMask() const {
+        int headRow = headIndex / cols;
+        int headCol = headIndex % cols;
+        int mask = 0;
+        if (headRow > 0 && !wallBits.test(headIndex - cols) && !isSelfCollision(headIndex - cols)) mask |= 1 << UP;
+        if (headRow < rows - 1 && !wallBits.test(headIndex + cols) && !isSelfCollision(headIndex + cols)) mask |= 1 << DOWN;
+        if (headCol > 0 && !wallBits.test(headIndex - 1) && !isSelfCollision(headIndex - 1)) mask |= 1 << LEFT;
+        if (headCol < cols - 1 && !wallBits.test(headIndex + 1) && !isSelfCollision(headIndex + 1)) mask |= 1 << RIGHT;
+        return mask;
+    }
+
+    /**
+     * @brief Counts empty cells with one popcount per word.
+     * @return Number of cells that are not snake, food or wall
+     */
+    int countEmptyCells() const {
+        int count = 0;
+        for (int w = 0; w < snakeBits.wordCount(); w++) {
+            count += popcount(emptyWord(w));
+        }
+        return count;
+    }
+
+    /**
+     * @brief Finds the nth empty cell in row-major order.
+     * @param n Zero-based rank, must be below countEmptyCells()
+     * @return Flat cell index of the empty cell
+     */
+    int findNthEmpty(int n) const {
+        for (int w = 0; w < snakeBits.wordCount(); w++) {
+            uint64_t empty = emptyWord(w);
+            int count = popcount(empty);
+            if (n < count) {
+                return w * 64 + selectBit(empty, n);
+            }
+            n -= count;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Replaces the current food with food at a given cell.
+     *
+     * Lets a caller mirror another engine's food placement when checking
+     * the two engines against each other.
+     * @param r Row index
+     * @param c Column index
+     */
+    void placeFoodAt(int r, int c) {
+        if (foodExists) foodBits.clear(foodIndex);
+        foodIndex = r * cols + c;
+        foodBits.set(foodIndex);
+        foodExists = true;
+    }
+
+    /**
+     * @brief Marks a cell as a wall.
+     * @param r Row index
+     * @param c Column index
+     */
+    void setWall(int r, int c) {
+        wallBits.set(r * cols + c);
+    }
+
+    /**
+     * @brief Gets the cell type at specified position.
+     * @param r Row index
+     * @param c Column index
+     * @return CellType at the position
+     */
+    int getCellType(int r, int c) const {
+        if (r < 0 || r >= rows || c < 0 || c >= cols) return WALL;
+        int index = r * cols + c;
+        if (snakeBits.test(index)) return SNAKE;
+        if (foodBits.test(index)) return FOOD;
+        if (wallBits.test(index)) return WALL;
+        return EMPTY;
+    }
+
+    /**
+     * @brief Gets the memory held by the board bit planes.
+     * @return Bytes used by all planes together
+     */
+    size_t boardMemoryBytes() const {
+        return snakeBits.memoryBytes() + foodBits.memoryBytes() + wallBits.memoryBytes() +
+               linkLow.memoryBytes() + linkHigh.memoryBytes();
+    }
+
+    pair<int, int> getHead() const { return {headIndex / cols, headIndex % cols}; }
+    pair<int, int> getTail() const { return {tailIndex / cols, tailIndex % cols}; }
+    pair<int, int> getFoodPosition() const { return {foodIndex / cols, foodIndex % cols}; }
+    bool isFoodPresent() const { return foodExists; }
+    int getLength() const { return length; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getScore() const { return score; }
+    bool isGameOver() const { return gameOver; }
+    Direction getCurrentDirection() const { return directionController.getCurrent(); }
+};
+
+#endif // BITBOARDLOGIC_H
@@ -0,0 +1,275 @@
+// distanceField.h
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include "gameLogic.h"
+#include <algorithm>
+#include <climits>
+
+// ============================================================================
+// INCREMENTAL DISTANCE FIELD
+// ============================================================================
+
+/**
+ * @brief Shortest-path distance from every cell to the food, kept up to
+ *        date from the board's cell transitions.
+ *
+ * Distances count moves through open cells (EMPTY or FOOD); snake and wall
+ * cells, and open cells cut off from the food, are Unreachable. The field
+ * listens to the board (SnakeGameLogic::setBoardListener()) and only
+ * queues transitions; refresh() then repairs it before use:
+ *
+ * - A cell opening up (the tail moving on) takes one more than its best
+ *   neighbor and spreads any shorter distances outwards.
+ * - A cell closing (the head moving in) invalidates, in order of distance,
+ *   the cells that no longer have a neighbor one step closer to the food.
+ *   Those get their best remaining neighbor plus one, and the new values
+ *   are spread nearest first with a FIFO merged against the sorted seeds.
+ * - A change to or from FOOD (food eaten, FoodManager::placeRandom()
+ *   respawning it) schedules a full breadth-first recompute, as do board
+ *   resets and a queue of changes too long to be worth replaying.
+ *
+ * A tick therefore costs time proportional to the cells whose distance
+ * actually changed. Buffers are sized once per board size.
+ */
+class DistanceField : public CellChangeListener {
+public:
+    static constexpr int32_t Unreachable = INT32_MAX;
+
+private:
+    static constexpr int QueueSlack = 8;
+
+    int rows;
+    int cols;
+    vector<int32_t> distance;
+    vector<uint8_t> open;           ///< 1 for EMPTY or FOOD, as of the changes applied so far
+    vector<CellChange> pending;     ///< Transitions since the last refresh()
+    vector<int32_t> queue;          ///< FIFO of cells, cellCount + QueueSlack entries
+    vector<pair<int32_t, int32_t>> seeds;   ///< (distance, cell) starts of a repair
+    bool rebuildPending;
+    long long rebuildCount;
+    long long repairedCells;        ///< Cells whose distance a repair rewrote
+
+    static bool isOpen(uint8_t type) { return !(type & 1); }   // EMPTY or FOOD
+
+    void resize(int newRows, int newCols) {
+        rows = newRows;
+        cols = newCols;
+        int cellCount = rows * cols;
+        distance.assign(cellCount, Unreachable);
+        open.assign(cellCount, 0);
+        queue.resize(cellCount + QueueSlack);
+        seeds.reserve(cellCount);
+        pending.reserve(max(16, cellCount / 16));
+    }
+
+    /**
+     * @brief Calls visit(neighbor) for each in-bounds neighbor of a cell.
+     */
+    template <typename Visit>
+    void forNeighbors(int index, Visit visit) const {
+        int col = index % cols;
+        if (index >= cols) visit(index - cols);
+        if (index + cols < rows * cols) visit(index + cols);
+        if (col > 0) visit(index - 1);
+        if (col + 1 < cols) visit(index + 1);
+    }
+
+    int32_t bestNeighbor(int index) const {
+        int32_t best = Unreachable;
+        forNeighbors(index, [&](int neighbor) { best = min(best, distance[neighbor]); });
+        return best;
+    }
+
+    /**
+     * @brief Spreads distances from the queued cells to open cells they shorten.
+     */
+    void spread(int queueHead, int queueTail) {
+        while (queueHead < queueTail) {
+            int cell = queue[queueHead++];
+            int32_t next = distance[cell] + 1;
+            forNeighbors(cell, [&](int neighbor) {
+                if (next < distance[neighbor] && open[neighbor]) {
+                    distance[neighbor] = next;
+                    queue[queueTail++] = neighbor;
+                    repairedCells++;
+                }
+            });
+        }
+    }
+
+    void rebuild(const Board& board) {
+        const uint8_t* cells = board.getCells().data();
+        fill(distance.begin(), distance.end(), Unreachable);
+        rebuildCount++;
+        int food = -1;
+        for (int i = 0; i < rows * cols; i++) {
+            open[i] = isOpen(cells[i]);
+            if (cells[i] == FOOD) food = i;
+        }
+        if (food < 0) return;
+        distance[food] = 0;
+        queue[0] = food;
+        long long repairedBefore = repairedCells;
+        spread(0, 1);
+        repairedCells = repairedBefore;
+    }
+
+    void openCell(int index) {
+        open[index] = 1;
+        int32_t best = bestNeighbor(index);
+        if (best == Unreachable) return;
+        distance[index] = best + 1;
+        repairedCells++;
+        queue[0] = index;
+        spread(0, 1);
+    }
+
+    void closeCell(int index) {
+        open[index] = 0;
+        int32_t old = distance[index];
+        distance[index] = Unreachable;
+        if (old == Unreachable) return;
+
+        // Invalidate level by level: a cell keeps its distance while some
+        // neighbor one step closer is still valid
+        int queueTail = 0;
+        forNeighbors(index, [&](int neighbor) {
+            if (distance[neighbor] == old + 1) queue[queueTail++] = neighbor;
+        });
+        int invalidEnd = 0;
+        for (int queueHead = 0; queueHead < queueTail; queueHead++) {
+            int cell = queue[queueHead];
+            int32_t level = distance[cell];
+            if (level == Unreachable) continue;
+            bool supported = false;
+            forNeighbors(cell, [&](int neighbor) { supported |= distance[neighbor] == level - 1; });
+            if (supported) continue;
+            distance[cell] = Unreachable;
+            queue[invalidEnd++] = cell;
+            // Entries before queueHead are spent, and invalidEnd never passes queueHead
+            forNeighbors(cell, [&](int neighbor) {
+                if (distance[neighbor] == level + 1) queue[queueTail++] = neighbor;
+            });
+            if (queueTail + 4 > static_cast<int>(queue.size())) {
+                // Pathologically many duplicate entries; start over instead
+                rebuildPending = true;
+                return;
+            }
+        }
+
+        seeds.clear();
+        for (int i = 0; i < invalidEnd; i++) {
+            int cell = queue[i];
+            int32_t best = bestNeighbor(cell);
+            if (best != Unreachable) seeds.push_back({best + 1, cell});
+        }
+        sort(seeds.begin(), seeds.end());
+
+        // Dijkstra order with unit edges: merge the sorted seeds into the FIFO
+        int queueHead = 0;
+        queueTail = 0;
+        size_t nextSeed = 0;
+        while (nextSeed < seeds.size() || queueHead < queueTail) {
+            int cell;
+            if (queueHead < queueTail &&
+                (nextSeed == seeds.size() || distance[queue[queueHead]] <= seeds[nextSeed].first)) {
+                cell = queue[queueHead++];
+            } else {
+                auto [seedDistance, seedCell] = seeds[nextSeed++];
+                if (seedDistance >= distance[seedCell]) continue;
+                distance[seedCell] = seedDistance;
+                repairedCells++;
+                cell = seedCell;
+            }
+            int32_t next = distance[cell] + 1;
+            forNeighbors(cell, [&](int neighbor) {
+                if (next < distance[neighbor] && open[neighbor]) {
+                    distance[neighbor] = next;
+                    queue[queueTail++] = neighbor;
+                    repairedCells++;
+                }
+            });
+        }
+    }
+
+public:
+    DistanceField()
+        : rows(0), cols(0), rebuildPending(true), rebuildCount(0), repairedCells(0) {}
+
+    /**
+     * @brief Subscribes to a game's board; the next refresh() rebuilds.
+     */
+    void attach(SnakeGameLogic& game) {
+        game.setBoardListener(this);
+        rebuildPending = true;
+        pending.clear();
+    }
+
+    void detach(SnakeGameLogic& game) {
+        game.setBoardListener(nullptr);
+    }
+
+    void onCellChange(const CellChange& change) override {
+        if (rebuildPending) return;
+        if (change.oldType == FOOD || change.newType == FOOD || pending.size() == pending.capacity()) {
+            rebuildPending = true;
+            pending.clear();
+            return;
+        }
+        pending.push_back(change);
+    }
+
+    void onBoardReset() override {
+        rebuildPending = true;
+        pending.clear();
+    }
+
+    /**
+     * @brief Brings the field up to date with the board; call after update().
+     * @param board Board of the attached game
+     */
+    void refresh(const Board& board) {
+        if (board.getRows() != rows || board.getCols() != cols) {
+            resize(board.getRows(), board.getCols());
+            rebuildPending = true;
+        }
+        for (size_t i = 0; i < pending.size() && !rebuildPending; i++) {
+            const CellChange& change = pending[i];
+            bool wasOpen = isOpen(change.oldType);
+            bool nowOpen = isOpen(change.newType);
+            if (wasOpen && !nowOpen) {
+                closeCell(change.index);
+            } else if (!wasOpen && nowOpen) {
+                openCell(change.index);
+            }
+        }
+        pending.clear();
+        if (rebuildPending) {
+            rebuildPending = false;
+            rebuild(board);
+        }
+    }
+
+    /**
+     * @brief Forces a full recompute, as a reference or after external edits.
+     */
+    void recompute(const Board& board) {
+        rebuildPending = true;
+        pending.clear();
+        refresh(board);
+    }
+
+    /**
+     * @brief Gets a cell's distance to the food as of the last refresh().
+     * @return Moves to the food, or Unreachable
+     */
+    int32_t getDistance(int r, int c) const { return distance[r * cols + c]; }
+    int32_t getDistance(int index) const { return distance[index]; }
+    const vector<int32_t>& getDistances() const { return distance; }
+
+    long long getRebuildCount() const { return rebuildCount; }
+    long long getRepairedCells() const { return repairedCells; }
+};
+
+#endif // DISTANCEFIELD_H
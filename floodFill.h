@@ -0,0 +1,280 @@
+// floodFill.h
+#ifndef FLOODFILL_H
+#define FLOODFILL_H
+
+#include "autopilot.h"
+#include <bit>
+#include <cstring>
+
+// ============================================================================
+// BIT-PARALLEL FLOOD FILL
+// ============================================================================
+
+/**
+ * @brief Reachable space after one candidate move.
+ */
+struct MoveSpace {
+    Direction direction;
+    bool legal;                     ///< Move survives the next tick
+    int area;                       ///< Empty cells reachable from the new head
+    bool tailReachable;             ///< A reachable cell touches the tail after the move
+};
+
+/**
+ * @brief Flood fills the board 64 cells at a time for autopilot safety checks.
+ *
+ * Each board row is a bitmask of passable cells (EMPTY or FOOD), padded to
+ * whole 64-bit words so a row shifts as one unit. A fill grows its reached
+ * set by dilation: every row takes in the rows above and below, then
+ * spreads along its runs of passable cells with a log-step shift/and/or
+ * ladder. Sweeps alternate downwards and upwards, so reach spreads through
+ * many rows per sweep, and repeat until nothing changes. Buffers are sized
+ * once per board size.
+ */
+class FloodFill {
+private:
+    int rows;
+    int cols;
+    int words;                      ///< 64-bit words per row
+    vector<uint64_t> passable;      ///< rows * words, one bit per EMPTY or FOOD cell
+    vector<uint64_t> reach;         ///< (rows + 2) * words, cells reached by the last
+                                    ///< flood, with an empty row above and below
+    vector<uint64_t> scratch;       ///< One row being dilated
+
+    /**
+     * @brief Spreads set bits along runs of passable bits within one word.
+     *
+     * Adding the seeds to the mask carries each run's lowest seed up to the
+     * top of its run in one step; a log-step shift ladder then spreads the
+     * result back down to the bottom of the run.
+     */
+    static uint64_t spreadWord(uint64_t seed, uint64_t open) {
+        uint64_t seeds = seed & open;
+        uint64_t spread = (((open + seeds) ^ open) | seeds) & open;
+        uint64_t downOpen = open;
+        for (int shift = 1; shift < 64; shift <<= 1) {
+            spread |= downOpen & (spread >> shift);
+            downOpen &= downOpen >> shift;
+        }
+        return spread;
+    }
+
+    /**
+     * @brief Spreads a row's reached bits along its passable runs, across words.
+     */
+    void spreadRow(uint64_t* row, const uint64_t* open) const {
+        if (words == 1) {
+            row[0] = spreadWord(row[0], open[0]);
+            return;
+        }
+        bool carried;
+        do {
+            carried = false;
+            for (int w = 0; w < words; w++) row[w] = spreadWord(row[w], open[w]);
+            for (int w = 1; w < words; w++) {
+                uint64_t toHigh = (row[w - 1] >> 63) & open[w] & ~row[w] & 1;
+                uint64_t toLow = (row[w] << 63) & open[w - 1] & ~row[w - 1];
+                row[w] |= toHigh;
+                row[w - 1] |= toLow;
+                carried |= (toHigh | toLow) != 0;
+            }
+        } while (carried);
+    }
+
+    /**
+     * @brief Recomputes one row of reach from itself and its neighbors.
+     * @return True if the row gained cells
+     */
+    bool dilateRow(int r) {
+        uint64_t* row = reachRow(r);
+        const uint64_t* above = row - words;
+        const uint64_t* below = row + words;
+        const uint64_t* open = &passable[r * words];
+        if (words == 1) {
+            uint64_t grown = (row[0] | above[0] | below[0]) & open[0];
+            if (!(grown & ~row[0])) return false;
+            row[0] = spreadWord(grown, open[0]);
+            return true;
+        }
+        uint64_t* next = scratch.data();
+        uint64_t any = 0;
+        for (int w = 0; w < words; w++) {
+            next[w] = (row[w] | above[w] | below[w]) & open[w];
+            any |= next[w] & ~row[w];
+        }
+        if (!any) return false;
+        spreadRow(next, open);
+        memcpy(row, next, words * sizeof(uint64_t));
+        return true;
+    }
+
+    uint64_t* reachRow(int r) { return &reach[(r + 1) * words]; }
+    const uint64_t* reachRow(int r) const { return &reach[(r + 1) * words]; }
+
+    void setOpen(int r, int c, bool open) {
+        uint64_t bit = uint64_t(1) << (c & 63);
+        uint64_t& word = passable[r * words + (c >> 6)];
+        word = open ? word | bit : word & ~bit;
+    }
+
+    bool isOpen(int r, int c) const {
+        return (passable[r * words + (c >> 6)] >> (c & 63)) & 1;
+    }
+
+    /**
+     * @brief Checks whether a reached cell is the given cell or next to it.
+     */
+    bool touches(int r, int c) const {
+        if (isReached(r, c)) return true;
+        for (int d = 0; d < 4; d++) {
+            int nr = r + MoveHelper::rowDelta[d];
+            int nc = c + MoveHelper::colDelta[d];
+            if (nr >= 0 && nr < rows && nc >= 0 && nc < cols && isReached(nr, nc)) return true;
+        }
+        return false;
+    }
+
+public:
+    FloodFill() : rows(0), cols(0), words(0) {}
+
+    /**
+     * @brief Builds the passable masks from a board.
+     *
+     * Converts eight cells per step: EMPTY and FOOD are the cell types with
+     * bit 0 clear, and one multiply gathers those bits into a byte.
+     */
+    void load(const Board& board) {
+        if (board.getRows() != rows || board.getCols() != cols) {
+            rows = board.getRows();
+            cols = board.getCols();
+            words = (cols + 63) / 64;
+            passable.assign(static_cast<size_t>(rows) * words, 0);
+            reach.assign(static_cast<size_t>(rows + 2) * words, 0);
+            scratch.assign(words, 0);
+        }
+        for (int r = 0; r < rows; r++) {
+            const uint8_t* cells = board.getRow(r);
+            uint64_t* row = &passable[r * words];
+            memset(row, 0, words * sizeof(uint64_t));
+            int c = 0;
+            for (; c + 8 <= cols; c += 8) {
+                uint64_t packed;
+                memcpy(&packed, cells + c, sizeof(packed));
+                uint64_t open = ~packed & 0x0101010101010101ULL;
+                row[c >> 6] |= ((open * 0x0102040810204080ULL) >> 56) << (c & 63);
+            }
+            for (; c < cols; c++) {
+                if (!(cells[c] & 1)) row[c >> 6] |= uint64_t(1) << (c & 63);
+            }
+        }
+    }
+
+    /**
+     * @brief Floods from one cell through the loaded passable cells.
+     *
+     * The start cell counts as reached even if it is not passable.
+     * @return Number of reached cells, including the start
+     */
+    int flood(int row, int col) {
+        fill(reach.begin(), reach.end(), 0);
+        uint64_t* start = reachRow(row);
+        start[col >> 6] = uint64_t(1) << (col & 63);
+        bool wasOpen = isOpen(row, col);
+        setOpen(row, col, true);
+        spreadRow(start, &passable[row * words]);
+
+        // Only rows next to reached rows can change, so sweep that band
+        int top = row;
+        int bottom = row;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int r = max(top - 1, 0); r <= min(bottom + 1, rows - 1); r++) {
+                if (dilateRow(r)) {
+                    changed = true;
+                    top = min(top, r);
+                    bottom = max(bottom, r);
+                }
+            }
+            for (int r = min(bottom + 1, rows - 1); r >= max(top - 1, 0); r--) {
+                if (dilateRow(r)) {
+                    changed = true;
+                    top = min(top, r);
+                    bottom = max(bottom, r);
+                }
+            }
+        }
+        setOpen(row, col, wasOpen);
+
+        int area = 0;
+        for (int r = top; r <= bottom; r++) {
+            const uint64_t* reached = reachRow(r);
+            for (int w = 0; w < words; w++) area += popcount(reached[w]);
+        }
+        return area;
+    }
+
+    /**
+     * @brief Checks whether the last flood reached a cell.
+     */
+    bool isReached(int row, int col) const {
+        return (reachRow(row)[col >> 6] >> (col & 63)) & 1;
+    }
+
+    /**
+     * @brief Measures the space left by each move other than reversing.
+     *
+     * For each move, the head cell becomes the fill's start and, unless the
+     * move eats food or growth is pending, the tail cell opens up as it
+     * would on the tick. The tail counts as reachable when a reached cell
+     * is next to the segment that will be the tail after the move.
+     * @param game Game to inspect, between two update() calls
+     * @param out Space per candidate move (4 entries when the snake is not moving)
+     * @return Number of entries written to out
+     */
+    int evaluateMoves(const SnakeGameLogic& game, MoveSpace* out) {
+        const Board& board = game.getBoard();
+        load(board);
+        const Snake& snake = game.getSnake();
+        const SnakeBody& body = snake.getBody();
+        pair<int, int> head = snake.getHead();
+        pair<int, int> tail = body.back();
+        bool tailOnBoard = board.isInBounds(tail.first, tail.second);
+        int length = static_cast<int>(body.size());
+        Direction reverse = MoveHelper::opposite(game.getCurrentDirection());
+        const FoodManager& food = game.getFoodManager();
+
+        int count = 0;
+        for (int d = 0; d < 4; d++) {
+            Direction dir = static_cast<Direction>(d);
+            if (dir == reverse) continue;
+            MoveSpace& space = out[count++];
+            space = {dir, MoveHelper::isSafe(game, dir), 0, false};
+            if (!space.legal) continue;
+
+            pair<int, int> target = {head.first + MoveHelper::rowDelta[d],
+                                     head.second + MoveHelper::colDelta[d]};
+            bool grows = snake.hasPendingGrowth() || (food.isPresent() && food.getPosition() == target);
+            bool opensTail = !grows && tailOnBoard;
+            if (opensTail) setOpen(tail.first, tail.second, true);
+            space.area = flood(target.first, target.second) - 1;
+            if (opensTail) setOpen(tail.first, tail.second, false);
+
+            // Off-board segments (see Snake::initialize()) only ever drop
+            // off, so the last segment on the board stands in for the tail
+            int nextTailIndex = grows || length < 2 ? length - 1 : length - 2;
+            while (nextTailIndex > 0 && !board.isInBounds(body[nextTailIndex].first,
+                                                          body[nextTailIndex].second)) {
+                nextTailIndex--;
+            }
+            pair<int, int> nextTail = body[nextTailIndex];
+            space.tailReachable = length < 2 || touches(nextTail.first, nextTail.second);
+        }
+        return count;
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+};
+
+#endif // FLOODFILL_H
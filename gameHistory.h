@@ -0,0 +1,274 @@
+// gameHistory.h
+#ifndef GAMEHISTORY_H
+#define GAMEHISTORY_H
+
+#include "gameLogic.h"
+
+// ============================================================================
+// PERSISTENT BOARD
+// ============================================================================
+
+/**
+ * @brief Immutable board stored as shared tiles, for cheap long histories.
+ *
+ * Cells are split into fixed-size tiles, and tiles are grouped under a
+ * small root. Deriving the next version with withChanges() copies only the
+ * tiles and groups that the changes touch; every other tile is shared with
+ * the previous version. A tick touching 1 to 3 cells therefore costs a few
+ * hundred bytes instead of a full board copy.
+ */
+class PersistentBoard {
+public:
+    static constexpr int TileCells = 256;
+    static constexpr int GroupTiles = 32;
+
+private:
+    struct Tile {
+        array<uint8_t, TileCells> cells;
+    };
+
+    struct TileGroup {
+        array<shared_ptr<const Tile>, GroupTiles> tiles;
+    };
+
+    vector<shared_ptr<const TileGroup>> groups;
+    int rows = 0;
+    int cols = 0;
+
+    const Tile& tileAt(int tileIndex) const {
+        return *groups[tileIndex / GroupTiles]->tiles[tileIndex % GroupTiles];
+    }
+
+public:
+    /**
+     * @brief Builds a board from a row-major cell buffer.
+     *
+     * Tiles whose content matches the same tile of a previous version are
+     * shared instead of copied, so rebuilding after a missed delta still
+     * keeps memory proportional to what actually changed.
+     * @param cells Row-major cells (rows * cols)
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param previous Version to share identical tiles with, or nullptr
+     * @return New board version
+     */
+    static PersistentBoard fromCells(const vector<uint8_t>& cells, int rows, int cols,
+                                     const PersistentBoard* previous = nullptr) {
+        PersistentBoard board;
+        board.rows = rows;
+        board.cols = cols;
+
+        int cellCount = rows * cols;
+        int tileCount = (cellCount + TileCells - 1) / TileCells;
+        int groupCount = (tileCount + GroupTiles - 1) / GroupTiles;
+        bool canShare = previous && previous->rows == rows && previous->cols == cols;
+
+        board.groups.resize(groupCount);
+        for (int g = 0; g < groupCount; g++) {
+            auto group = make_shared<TileGroup>();
+            bool groupUnchanged = canShare;
+            for (int t = 0; t < GroupTiles; t++) {
+                int tileIndex = g * GroupTiles + t;
+                if (tileIndex >= tileCount) break;
+
+                int begin = tileIndex * TileCells;
+                int length = min(TileCells, cellCount - begin);
+                if (canShare) {
+                    const auto& previousTile = previous->groups[g]->tiles[t];
+                    if (memcmp(previousTile->cells.data(), cells.data() + begin, length) == 0) {
+                        group->tiles[t] = previousTile;
+                        continue;
+                    }
+                }
+
+                auto tile = make_shared<Tile>();
+                tile->cells.fill(EMPTY);
+                memcpy(tile->cells.data(), cells.data() + begin, length);
+                group->tiles[t] = tile;
+                groupUnchanged = false;
+            }
+            board.groups[g] = groupUnchanged ? previous->groups[g] : group;
+        }
+        return board;
+    }
+
+    /**
+     * @brief Derives the next version by applying cell changes.
+     * @param changes Changes in the order they were made
+     * @return New board version sharing all untouched tiles
+     */
+    PersistentBoard withChanges(const vector<CellChange>& changes) const {
+        PersistentBoard next = *this;
+        shared_ptr<TileGroup> copiedGroups[4];
+        shared_ptr<Tile> copiedTiles[4];
+        int copiedGroupIndex[4];
+        int copiedTileIndex[4];
+        int groupCopies = 0;
+        int tileCopies = 0;
+
+        for (const CellChange& change : changes) {
+            int tileIndex = change.index / TileCells;
+            int groupIndex = tileIndex / GroupTiles;
+
+            // A tick touches a handful of cells, so linear lookups are fine
+            TileGroup* group = nullptr;
+            for (int i = 0; i < groupCopies; i++) {
+                if (copiedGroupIndex[i] == groupIndex) group = copiedGroups[i].get();
+            }
+            if (!group) {
+                if (groupCopies == 4) return fromCells(materialize(changes), rows, cols, this);
+                copiedGroups[groupCopies] = make_shared<TileGroup>(*groups[groupIndex]);
+                copiedGroupIndex[groupCopies] = groupIndex;
+                group = copiedGroups[groupCopies++].get();
+                next.groups[groupIndex] = copiedGroups[groupCopies - 1];
+            }
+
+            Tile* tile = nullptr;
+            for (int i = 0; i < tileCopies; i++) {
+                if (copiedTileIndex[i] == tileIndex) tile = copiedTiles[i].get();
+            }
+            if (!tile) {
+                if (tileCopies == 4) return fromCells(materialize(changes), rows, cols, this);
+                copiedTiles[tileCopies] = make_shared<Tile>(tileAt(tileIndex));
+                copiedTileIndex[tileCopies] = tileIndex;
+                tile = copiedTiles[tileCopies++].get();
+                group->tiles[tileIndex % GroupTiles] = copiedTiles[tileCopies - 1];
+            }
+
+            tile->cells[change.index % TileCells] = change.newType;
+        }
+        return next;
+    }
+
+    /**
+     * @brief Expands the board into a row-major buffer with changes applied.
+     * @param changes Changes to apply on top of this version
+     * @return Row-major cells
+     */
+    vector<uint8_t> materialize(const vector<CellChange>& changes = {}) const {
+        vector<uint8_t> cells;
+        copyTo(cells);
+        for (const CellChange& change : changes) {
+            cells[change.index] = change.newType;
+        }
+        return cells;
+    }
+
+    /**
+     * @brief Copies the board into a row-major buffer.
+     * @param out Destination; resized to rows * cols
+     */
+    void copyTo(vector<uint8_t>& out) const {
+        int cellCount = rows * cols;
+        out.resize(cellCount);
+        for (int begin = 0; begin < cellCount; begin += TileCells) {
+            int length = min(TileCells, cellCount - begin);
+            memcpy(out.data() + begin, tileAt(begin / TileCells).cells.data(), length);
+        }
+    }
+
+    int cellAt(int r, int c) const {
+        int index = r * cols + c;
+        return tileAt(index / TileCells).cells[index % TileCells];
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+};
+
+// ============================================================================
+// GAME HISTORY
+// ============================================================================
+
+/**
+ * @brief One retained tick of game history.
+ *
+ * Only the head of the snake is kept; the body cells are on the board.
+ */
+struct HistoryEntry {
+    uint64_t sequence;
+    int score;
+    bool gameOver;
+    pair<int, int> food;
+    bool foodExists;
+    PackedCell head;
+    int snakeLength;
+    PersistentBoard board;
+};
+
+/**
+ * @brief Bounded history of published snapshots for rewind and replay.
+ *
+ * Feed it every snapshot a consumer sees. Consecutive delta snapshots are
+ * stored by applying their changes to the previous board version, so only
+ * touched tiles are copied. After a gap, a re-initialization, or when delta
+ * publishing is off, the board is rebuilt from the snapshot while still
+ * sharing every tile that did not change.
+ */
+class GameHistory {
+private:
+    vector<HistoryEntry> entries;   ///< Ring buffer, oldest overwritten first
+    size_t capacity;
+    size_t newest;
+    size_t count;
+
+public:
+    /**
+     * @brief Creates an empty history.
+     * @param capacity Maximum number of ticks retained
+     */
+    explicit GameHistory(size_t capacity) : capacity(capacity), newest(0), count(0) {
+        entries.reserve(capacity);
+    }
+
+    /**
+     * @brief Appends a published snapshot.
+     * @param state Snapshot, typically read through a StateView
+     */
+    void record(const GameState& state) {
+        const HistoryEntry* previous = count > 0 ? &latest() : nullptr;
+        bool sameBoard = previous && previous->board.getRows() == state.rows &&
+                         previous->board.getCols() == state.cols;
+
+        HistoryEntry entry;
+        entry.sequence = state.sequence;
+        entry.score = state.score;
+        entry.gameOver = state.gameOver;
+        entry.food = state.food;
+        entry.foodExists = state.foodExists;
+        entry.head = state.snake.empty() ? PackedCell{0, 0} : state.snake.front();
+        entry.snakeLength = state.snakeLength;
+
+        if (sameBoard && state.changesTracked && state.sequence == previous->sequence + 1) {
+            entry.board = previous->board.withChanges(state.changes);
+        } else {
+            entry.board = PersistentBoard::fromCells(state.board, state.rows, state.cols,
+                                                     sameBoard ? &previous->board : nullptr);
+        }
+
+        if (entries.size() < capacity) {
+            entries.push_back(move(entry));
+            newest = entries.size() - 1;
+        } else {
+            newest = (newest + 1) % capacity;
+            entries[newest] = move(entry);
+        }
+        count = entries.size();
+    }
+
+    /**
+     * @brief Gets an entry counted back from the newest.
+     * @param ticksAgo 0 for the newest entry, size() - 1 for the oldest
+     * @return Retained entry
+     */
+    const HistoryEntry& at(size_t ticksAgo) const {
+        return entries[(newest + capacity - ticksAgo) % capacity];
+    }
+
+    const HistoryEntry& latest() const { return entries[newest]; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { entries.clear(); newest = 0; count = 0; }
+};
+
+#endif // GAMEHISTORY_H
@@ -6,32 +6,96 @@
 #define NOMINMAX
 
 #include <iostream>
-#include <deque>
 #include <vector>
 #include <random>
 #include <atomic>
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <array>
 
 using namespace std;
 
+/**
+ * @brief Board position packed into two 16-bit coordinates.
+ * 
+ * Used for snake segments so the body fits in 4 bytes per cell and can be
+ * copied in bulk. Supports boards up to 65535 x 65535.
+ */
+struct PackedCell {
+    uint16_t row;
+    uint16_t col;
+
+    static PackedCell fromPosition(pair<int, int> pos) {
+        return {static_cast<uint16_t>(pos.first), static_cast<uint16_t>(pos.second)};
+    }
+
+    pair<int, int> toPosition() const { return {row, col}; }
+};
+
+/**
+ * @brief One cell transition recorded by the board during a tick.
+ */
+struct CellChange {
+    int index;                       ///< Flat cell index (r * cols + c)
+    uint8_t oldType;                 ///< CellType before the change
+    uint8_t newType;                 ///< CellType after the change
+};
+
+/**
+ * @brief Receives a board's cell transitions as they happen.
+ *
+ * Called on the game thread from inside setCellType() and rollback(), in
+ * the middle of a tick, so implementations should record what changed
+ * and do their work when next queried.
+ */
+class CellChangeListener {
+public:
+    virtual ~CellChangeListener() = default;
+    virtual void onCellChange(const CellChange& change) = 0;
+
+    /**
+     * @brief Called when any cell may have changed without individual
+     *        notifications (initialize(), copyFrom()).
+     */
+    virtual void onBoardReset() = 0;
+};
+
 /**
  * @brief Immutable snapshot of the game state at a specific point in time.
  * 
- * This structure is designed to be thread-safe when accessed through
- * shared_ptr with proper memory ordering. All fields are copied from
- * the game logic state during publishing.
+ * This structure is designed to be thread-safe when accessed through a
+ * StateView, which pins it against being overwritten. All fields are
+ * copied from the game logic state during publishing.
+ * 
+ * Consumers can follow the game incrementally: when a snapshot's sequence
+ * is exactly one past the last one seen, applying its changes brings a
+ * local board up to date. After a gap, the full board is always valid and
+ * can be copied instead. In delta publishing mode, snake holds only the
+ * head segment.
  */
 struct GameState {
-    vector<vector<int>> board;      ///< 2D grid representing the game board
+    vector<uint8_t> board;          ///< Row-major cell buffer (rows * cols, one byte per cell)
     int rows;                        ///< Number of rows in the board
     int cols;                        ///< Number of columns in the board
     int score;                       ///< Current game score
     bool gameOver;                   ///< Game over flag
     pair<int, int> food;            ///< Current food position
     bool foodExists;                 ///< Whether food is present on the board
-    deque<pair<int, int>> snake;    ///< Snake body segments
+    vector<PackedCell> snake;       ///< Snake body segments, head first
     int snakeLength;                 ///< Current length of the snake
+    uint64_t sequence;               ///< Tick sequence number, +1 per publish
+    vector<CellChange> changes;      ///< Cell changes since the previous sequence (delta mode)
+    bool changesTracked;             ///< Whether changes is populated (delta publishing is on)
+
+    /**
+     * @brief Reads a cell from the row-major board buffer.
+     * @param r Row index (must be in bounds)
+     * @param c Column index (must be in bounds)
+     * @return CellType at the position
+     */
+    int cellAt(int r, int c) const { return board[r * cols + c]; }
 };
 
 // ============================================================================
@@ -69,6 +133,17 @@ enum CellType {
     WALL = 3 
 };
 
+/**
+ * @brief Why a game ended, as reported by GameRules::tick().
+ */
+enum GameOverReason {
+    NOT_OVER = 0,       ///< Game still running
+    OUT_OF_BOUNDS = 1,  ///< Head left the board
+    HIT_WALL = 2,       ///< Head entered a wall cell
+    HIT_SELF = 3,       ///< Head entered the snake's own body
+    BOARD_FULL = 4      ///< No empty cell left for food
+};
+
 // ============================================================================
 // BOARD MANAGEMENT
 // ============================================================================
@@ -82,10 +157,40 @@ enum CellType {
  */
 class Board {
 private:
-    vector<vector<int>> grid;
+    /**
+     * @brief Enough to undo one setCellType(), free-cell order included.
+     */
+    struct UndoEntry {
+        int index;
+        int freeSlot;               ///< Slot the cell left in freeCells, or -1
+        uint8_t oldType;
+    };
+
+    vector<uint8_t> cells;          ///< Row-major storage, cell (r, c) lives at r * cols + c
+    vector<int> freeCells;          ///< Dense list of flat indices of all EMPTY cells
+    vector<int> freeSlot;           ///< Flat index -> slot in freeCells, or -1 if not EMPTY
+    vector<CellChange> changeLog;   ///< Cell changes since the last clearChanges()
+    vector<UndoEntry> journal;      ///< Undo entries while journaling is on
+    CellChangeListener* listener = nullptr;
+    bool trackChanges = false;
+    bool journaling = false;
     int rows;
     int cols;
 
+    void markOccupied(int index) {
+        int slot = freeSlot[index];
+        int last = freeCells.back();
+        freeCells[slot] = last;
+        freeSlot[last] = slot;
+        freeCells.pop_back();
+        freeSlot[index] = -1;
+    }
+
+    void markFree(int index) {
+        freeSlot[index] = static_cast<int>(freeCells.size());
+        freeCells.push_back(index);
+    }
+
 public:
     /**
      * @brief Initializes the board with specified dimensions.
@@ -95,7 +200,17 @@ public:
     void initialize(int rows, int cols) {
         this->rows = rows;
         this->cols = cols;
-        grid = vector<vector<int>>(rows, vector<int>(cols, EMPTY));
+        int cellCount = rows * cols;
+        cells.assign(cellCount, EMPTY);
+        changeLog.clear();
+        journal.clear();
+        freeCells.resize(cellCount);
+        freeSlot.resize(cellCount);
+        for (int i = 0; i < cellCount; i++) {
+            freeCells[i] = i;
+            freeSlot[i] = i;
+        }
+        if (listener) listener->onBoardReset();
     }
 
     /**
@@ -108,6 +223,16 @@ public:
         return r >= 0 && r < rows && c >= 0 && c < cols;
     }
 
+    /**
+     * @brief Converts a position to its offset in the row-major buffer.
+     * @param r Row index (must be in bounds)
+     * @param c Column index (must be in bounds)
+     * @return Flat cell index
+     */
+    int indexOf(int r, int c) const {
+        return r * cols + c;
+    }
+
     /**
      * @brief Gets the cell type at specified position.
      * @param r Row index
@@ -116,40 +241,387 @@ public:
      */
     int getCellType(int r, int c) const {
         if (!isInBounds(r, c)) return WALL;
-        return grid[r][c];
+        return cells[indexOf(r, c)];
     }
 
     /**
      * @brief Sets the cell type at specified position.
+     * 
+     * Keeps the free-cell index in sync: a cell leaving EMPTY is swapped
+     * out of the dense list, a cell becoming EMPTY is appended to it.
      * @param r Row index
      * @param c Column index
      * @param cellType Type to set
      */
     void setCellType(int r, int c, int cellType) {
-        if (isInBounds(r, c)) {
-            grid[r][c] = cellType;
+        if (!isInBounds(r, c)) return;
+        
+        int index = indexOf(r, c);
+        int oldType = cells[index];
+        if (journaling && oldType != cellType) {
+            journal.push_back({index, freeSlot[index], static_cast<uint8_t>(oldType)});
+        }
+        if (oldType == EMPTY && cellType != EMPTY) {
+            markOccupied(index);
+        } else if (oldType != EMPTY && cellType == EMPTY) {
+            markFree(index);
+        }
+        if (trackChanges && oldType != cellType) {
+            changeLog.push_back({index, static_cast<uint8_t>(oldType), static_cast<uint8_t>(cellType)});
+        }
+        if (listener && oldType != cellType) {
+            listener->onCellChange({index, static_cast<uint8_t>(oldType), static_cast<uint8_t>(cellType)});
+        }
+        cells[index] = static_cast<uint8_t>(cellType);
+    }
+
+    /**
+     * @brief Enables or disables the undo journal used by rollback().
+     * @param enabled True to journal every cell transition
+     */
+    void setJournaling(bool enabled) {
+        journaling = enabled;
+        journal.clear();
+    }
+
+    /**
+     * @brief Gets the journal position to pass to rollback() later.
+     * @return Number of journaled cell transitions
+     */
+    size_t getJournalSize() const { return journal.size(); }
+    bool isJournaling() const { return journaling; }
+
+    /**
+     * @brief Undoes every cell transition journaled after a position.
+     * 
+     * Reverses the free-cell swaps exactly, so the free-cell order (and
+     * therefore where the next food lands) matches the journaled point.
+     * Cost is proportional to the number of undone transitions; the change
+     * log for delta publishing is not updated.
+     * @param journalSize Position from getJournalSize()
+     */
+    void rollback(size_t journalSize) {
+        while (journal.size() > journalSize) {
+            UndoEntry entry = journal.back();
+            journal.pop_back();
+            int index = entry.index;
+            if (entry.oldType == EMPTY) {
+                // Undo markOccupied(): put the cell back at its slot and move
+                // the cell that filled the hole back to the end
+                int slot = entry.freeSlot;
+                if (slot == static_cast<int>(freeCells.size())) {
+                    freeCells.push_back(index);
+                } else {
+                    int moved = freeCells[slot];
+                    freeSlot[moved] = static_cast<int>(freeCells.size());
+                    freeCells.push_back(moved);
+                    freeCells[slot] = index;
+                }
+                freeSlot[index] = slot;
+            } else if (cells[index] == EMPTY) {
+                // Undo markFree(): the cell was appended last
+                freeCells.pop_back();
+                freeSlot[index] = -1;
+            }
+            if (listener && cells[index] != entry.oldType) {
+                listener->onCellChange({index, cells[index], entry.oldType});
+            }
+            cells[index] = entry.oldType;
         }
     }
 
+    /**
+     * @brief Copies another board's cells and free-cell index.
+     * 
+     * Reuses this board's buffers; change tracking and journaling are
+     * turned off rather than copied, and this board's listener (not the
+     * other's) stays attached and is told to start over.
+     * @param other Board to copy
+     */
+    void copyFrom(const Board& other) {
+        rows = other.rows;
+        cols = other.cols;
+        cells = other.cells;
+        freeCells = other.freeCells;
+        freeSlot = other.freeSlot;
+        changeLog.clear();
+        journal.clear();
+        trackChanges = false;
+        journaling = false;
+        if (listener) listener->onBoardReset();
+    }
+
+    /**
+     * @brief Attaches the single listener told about every cell transition.
+     * @param changeListener Listener, or nullptr to detach
+     */
+    void setChangeListener(CellChangeListener* changeListener) { listener = changeListener; }
+    CellChangeListener* getChangeListener() const { return listener; }
+
+    /**
+     * @brief Enables or disables recording of cell changes.
+     * @param enabled True to append every cell transition to the change log
+     */
+    void setChangeTracking(bool enabled) {
+        trackChanges = enabled;
+        changeLog.clear();
+        if (enabled) changeLog.reserve(8);
+    }
+
+    /**
+     * @brief Gets the cell changes recorded since the last clearChanges().
+     * @return Changes in the order they were made
+     */
+    const vector<CellChange>& getChanges() const { return changeLog; }
+
+    void clearChanges() { changeLog.clear(); }
+
+    /**
+     * @brief Gets the number of empty cells in O(1).
+     * @return Count of EMPTY cells
+     */
+    int getEmptyCount() const {
+        return static_cast<int>(freeCells.size());
+    }
+
+    /**
+     * @brief Gets an empty cell by its slot in the free-cell index.
+     * 
+     * Slot order is arbitrary and changes as cells are occupied and freed;
+     * it is only meant for picking a uniformly random empty cell.
+     * @param slot Slot in [0, getEmptyCount())
+     * @return Position of the empty cell
+     */
+    pair<int, int> getEmptyCell(int slot) const {
+        int index = freeCells[slot];
+        return {index / cols, index % cols};
+    }
+
     /**
      * @brief Gets all empty cell positions on the board.
-     * @return Vector of empty cell coordinates
+     * @return Vector of empty cell coordinates, in free-cell index order
      */
     vector<pair<int, int>> getEmptyCells() const {
         vector<pair<int, int>> emptyCells;
-        for (int r = 0; r < rows; r++) {
-            for (int c = 0; c < cols; c++) {
-                if (grid[r][c] == EMPTY) {
-                    emptyCells.push_back({r, c});
-                }
-            }
+        emptyCells.reserve(freeCells.size());
+        for (int slot = 0; slot < getEmptyCount(); slot++) {
+            emptyCells.push_back(getEmptyCell(slot));
         }
         return emptyCells;
     }
 
     int getRows() const { return rows; }
     int getCols() const { return cols; }
-    const vector<vector<int>>& getGrid() const { return grid; }
+    const uint8_t* getRow(int r) const { return cells.data() + indexOf(r, 0); }
+    const vector<uint8_t>& getCells() const { return cells; }
+};
+
+/**
+ * @brief Board with dimensions fixed at compile time.
+ * 
+ * Same interface and free-cell index as Board, but storage lives in
+ * std::array members and all index math uses constant dimensions, so
+ * multiplies and divides by Cols are strength-reduced by the compiler.
+ * @tparam Rows Number of rows
+ * @tparam Cols Number of columns
+ */
+template <int Rows, int Cols>
+class FixedBoard {
+private:
+    static constexpr int CellCount = Rows * Cols;
+
+    array<uint8_t, CellCount> cells;
+    array<int, CellCount> freeCells;
+    array<int, CellCount> freeSlot;
+    int freeCount;
+
+    void markOccupied(int index) {
+        int slot = freeSlot[index];
+        int last = freeCells[--freeCount];
+        freeCells[slot] = last;
+        freeSlot[last] = slot;
+        freeSlot[index] = -1;
+    }
+
+    void markFree(int index) {
+        freeSlot[index] = freeCount;
+        freeCells[freeCount++] = index;
+    }
+
+public:
+    void initialize() {
+        cells.fill(EMPTY);
+        for (int i = 0; i < CellCount; i++) {
+            freeCells[i] = i;
+            freeSlot[i] = i;
+        }
+        freeCount = CellCount;
+    }
+
+    static constexpr bool isInBounds(int r, int c) {
+        return static_cast<unsigned>(r) < static_cast<unsigned>(Rows) &&
+               static_cast<unsigned>(c) < static_cast<unsigned>(Cols);
+    }
+
+    static constexpr int indexOf(int r, int c) {
+        return r * Cols + c;
+    }
+
+    int getCellType(int r, int c) const {
+        if (!isInBounds(r, c)) return WALL;
+        return cells[indexOf(r, c)];
+    }
+
+    void setCellType(int r, int c, int cellType) {
+        if (!isInBounds(r, c)) return;
+        
+        int index = indexOf(r, c);
+        int oldType = cells[index];
+        if (oldType == EMPTY && cellType != EMPTY) {
+            markOccupied(index);
+        } else if (oldType != EMPTY && cellType == EMPTY) {
+            markFree(index);
+        }
+        cells[index] = static_cast<uint8_t>(cellType);
+    }
+
+    int getEmptyCount() const { return freeCount; }
+
+    pair<int, int> getEmptyCell(int slot) const {
+        int index = freeCells[slot];
+        return {index / Cols, index % Cols};
+    }
+
+    static constexpr int getRows() { return Rows; }
+    static constexpr int getCols() { return Cols; }
+    const uint8_t* getRow(int r) const { return cells.data() + indexOf(r, 0); }
+    const array<uint8_t, CellCount>& getCells() const { return cells; }
+};
+
+// ============================================================================
+// SNAKE BODY STORAGE
+// ============================================================================
+
+/**
+ * @brief Fixed-capacity ring buffer holding the snake body, head first.
+ * 
+ * Storage is allocated once in reset() with room for every board cell, so
+ * pushing a new head or dropping the tail never allocates. The live
+ * segments occupy at most two contiguous spans of the buffer.
+ */
+class SnakeBody {
+public:
+    /**
+     * @brief Body position to return to with rollback().
+     */
+    struct Checkpoint {
+        size_t journalSize;
+        int headSlot;
+        int count;
+    };
+
+private:
+    struct Overwrite {
+        int slot;
+        PackedCell old;
+    };
+
+    vector<PackedCell> segments;
+    vector<Overwrite> journal;      ///< Slots overwritten by pushFront() while journaling
+    int headSlot;
+    int count;
+    bool journaling;
+
+    int slotOf(int i) const {
+        int slot = headSlot + i;
+        int capacity = static_cast<int>(segments.size());
+        return slot >= capacity ? slot - capacity : slot;
+    }
+
+public:
+    SnakeBody() : headSlot(0), count(0), journaling(false) {}
+
+    /**
+     * @brief Empties the body and sizes the buffer.
+     * @param capacity Maximum number of segments (rows * cols)
+     */
+    void reset(int capacity) {
+        segments.resize(capacity);
+        journal.clear();
+        headSlot = 0;
+        count = 0;
+    }
+
+    void pushFront(pair<int, int> pos) {
+        headSlot = headSlot == 0 ? static_cast<int>(segments.size()) - 1 : headSlot - 1;
+        if (journaling) journal.push_back({headSlot, segments[headSlot]});
+        segments[headSlot] = PackedCell::fromPosition(pos);
+        count++;
+    }
+
+    void pushBack(pair<int, int> pos) {
+        segments[slotOf(count)] = PackedCell::fromPosition(pos);
+        count++;
+    }
+
+    void popBack() {
+        count--;
+    }
+
+    /**
+     * @brief Copies the segments, head first, into a flat vector.
+     * @param out Destination; resized to the body length
+     */
+    void copyTo(vector<PackedCell>& out) const {
+        out.resize(count);
+        if (count == 0) return;
+        
+        int firstSpan = min(count, static_cast<int>(segments.size()) - headSlot);
+        memcpy(out.data(), segments.data() + headSlot, firstSpan * sizeof(PackedCell));
+        memcpy(out.data() + firstSpan, segments.data(), (count - firstSpan) * sizeof(PackedCell));
+    }
+
+    void setJournaling(bool enabled) {
+        journaling = enabled;
+        journal.clear();
+    }
+
+    Checkpoint checkpoint() const { return {journal.size(), headSlot, count}; }
+
+    /**
+     * @brief Restores the body to a checkpoint by undoing later pushFront() writes.
+     * @param checkpoint Taken while journaling was on
+     */
+    void rollback(const Checkpoint& checkpoint) {
+        while (journal.size() > checkpoint.journalSize) {
+            segments[journal.back().slot] = journal.back().old;
+            journal.pop_back();
+        }
+        headSlot = checkpoint.headSlot;
+        count = checkpoint.count;
+    }
+
+    /**
+     * @brief Copies another body's live segments; O(length), not O(capacity).
+     * @param other Body to copy; journaling is not copied
+     */
+    void copyFrom(const SnakeBody& other) {
+        segments.resize(other.segments.size());
+        journal.clear();
+        journaling = false;
+        headSlot = 0;
+        count = other.count;
+        if (count == 0) return;
+        int firstSpan = min(count, static_cast<int>(other.segments.size()) - other.headSlot);
+        memcpy(segments.data(), other.segments.data() + other.headSlot, firstSpan * sizeof(PackedCell));
+        memcpy(segments.data() + firstSpan, other.segments.data(), (count - firstSpan) * sizeof(PackedCell));
+    }
+
+    pair<int, int> front() const { return segments[headSlot].toPosition(); }
+    pair<int, int> back() const { return segments[slotOf(count - 1)].toPosition(); }
+    pair<int, int> operator[](int i) const { return segments[slotOf(i)].toPosition(); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
 };
 
 // ============================================================================
@@ -165,10 +637,15 @@ public:
  */
 class Snake {
 private:
-    deque<pair<int, int>> body;
+    SnakeBody body;
     int growthPending;
 
 public:
+    struct Checkpoint {
+        SnakeBody::Checkpoint body;
+        int growthPending;
+    };
+
     Snake() : growthPending(0) {}
 
     /**
@@ -178,8 +655,9 @@ public:
      * @param direction Initial movement direction
      * @param board Reference to the game board
      */
-    void initialize(pair<int, int> startPos, int length, Direction direction, Board& board) {
-        body.clear();
+    template <typename BoardType>
+    void initialize(pair<int, int> startPos, int length, Direction direction, BoardType& board) {
+        body.reset(max(board.getRows() * board.getCols(), length));
         growthPending = 0;
         
         int startRow = startPos.first;
@@ -197,27 +675,31 @@ public:
                 case NONE:  break;
             }
             
-            body.push_back({r, c});
+            body.pushBack({r, c});
             board.setCellType(r, c, SNAKE);
         }
     }
 
     /**
      * @brief Moves the snake to a new head position.
+     * 
+     * The tail is released before the head is written so that a head moving
+     * into the cell the tail is vacating ends up marked as SNAKE.
      * @param newHead New head position
      * @param board Reference to the game board
      */
-    void move(pair<int, int> newHead, Board& board) {
-        body.push_front(newHead);
-        board.setCellType(newHead.first, newHead.second, SNAKE);
-        
+    template <typename BoardType>
+    void move(pair<int, int> newHead, BoardType& board) {
         if (growthPending > 0) {
             growthPending--;
         } else {
             pair<int, int> tail = body.back();
-            body.pop_back();
+            body.popBack();
             board.setCellType(tail.first, tail.second, EMPTY);
         }
+        
+        body.pushFront(newHead);
+        board.setCellType(newHead.first, newHead.second, SNAKE);
     }
 
     /**
@@ -229,23 +711,159 @@ public:
     }
 
     /**
-     * @brief Checks if a position collides with the snake body.
+     * @brief Checks if moving the head to a position collides with the body.
+     * 
+     * Uses the board's SNAKE marking as an occupancy grid, so the check is
+     * O(1). The tail cell does not block when the snake is not growing,
+     * because the tail vacates it on the same tick the head moves in.
      * @param pos Position to check
+     * @param board Reference to the game board
      * @return True if collision detected, false otherwise
      */
-    bool checkSelfCollision(pair<int, int> pos) const {
-        for (size_t i = 1; i < body.size(); i++) {
-            if (body[i] == pos) return true;
-        }
-        return false;
+    template <typename BoardType>
+    bool checkSelfCollision(pair<int, int> pos, const BoardType& board) const {
+        if (board.getCellType(pos.first, pos.second) != SNAKE) return false;
+        return growthPending > 0 || pos != body.back();
+    }
+
+    void setJournaling(bool enabled) { body.setJournaling(enabled); }
+    Checkpoint checkpoint() const { return {body.checkpoint(), growthPending}; }
+
+    void rollback(const Checkpoint& checkpoint) {
+        body.rollback(checkpoint.body);
+        growthPending = checkpoint.growthPending;
+    }
+
+    void copyFrom(const Snake& other) {
+        body.copyFrom(other.body);
+        growthPending = other.growthPending;
     }
 
     pair<int, int> getHead() const { return body.front(); }
-    const deque<pair<int, int>>& getBody() const { return body; }
+    const SnakeBody& getBody() const { return body; }
     size_t getLength() const { return body.size(); }
     bool hasPendingGrowth() const { return growthPending > 0; }
 };
 
+// ============================================================================
+// RANDOM NUMBER GENERATION
+// ============================================================================
+
+/**
+ * @brief SplitMix64, used to expand seeds into generator state.
+ */
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+/**
+ * @brief xoshiro256++ generator: 32 bytes of state, reproducible, splittable.
+ * 
+ * seed(seed, stream) gives every (seed, stream) pair its own sequence, so
+ * game i of a parallel batch can simply use stream i. For a few very long
+ * streams, split() hands out the current sequence and jumps this generator
+ * 2^128 steps ahead, so the streams never overlap. Satisfies
+ * UniformRandomBitGenerator.
+ */
+class Xoshiro256 {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seedValue = 0, uint64_t stream = 0) { seed(seedValue, stream); }
+
+    /**
+     * @brief Restarts the generator on a seed and stream.
+     * @param seedValue Base seed, e.g. one per run
+     * @param stream Stream index, e.g. one per game
+     */
+    void seed(uint64_t seedValue, uint64_t stream = 0) {
+        // Hash the stream separately so nearby streams do not share SplitMix64 output
+        uint64_t streamHash = SplitMix64(stream ^ 0xD1B54A32D192ED03ULL).next();
+        SplitMix64 mixer(SplitMix64(seedValue).next() ^ streamHash);
+        for (uint64_t& word : s) word = mixer.next();
+    }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Draws a uniform integer in [0, bound) with Lemire's method.
+     * 
+     * One multiply in the common case; the rejection loop only runs for the
+     * few values that would bias the result.
+     * @param bound Exclusive upper bound, at least 1
+     * @return Uniform value below bound
+     */
+    uint32_t nextBounded(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>((*this)() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>((*this)() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    /**
+     * @brief Advances the generator by 2^128 steps.
+     */
+    void jump() {
+        static const uint64_t polynomial[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                              0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+        uint64_t jumped[4] = {0, 0, 0, 0};
+        for (uint64_t word : polynomial) {
+            for (int bit = 0; bit < 64; bit++) {
+                if (word & (uint64_t(1) << bit)) {
+                    for (int i = 0; i < 4; i++) jumped[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; i++) s[i] = jumped[i];
+    }
+
+    /**
+     * @brief Splits off a stream that never overlaps this one.
+     * @return Generator continuing the current sequence; this one jumps ahead
+     */
+    Xoshiro256 split() {
+        Xoshiro256 child = *this;
+        jump();
+        return child;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~uint64_t(0); }
+};
+
 // ============================================================================
 // FOOD MANAGEMENT
 // ============================================================================
@@ -254,36 +872,41 @@ public:
  * @brief Manages food placement and state on the game board.
  * 
  * Handles random food placement ensuring food appears only on empty cells.
- * Uses a random number generator for unpredictable food positions.
+ * Uses the owning game's generator, so a seeded game places food the same
+ * way every run.
  */
 class FoodManager {
 private:
     pair<int, int> position;
     bool exists;
-    mt19937& rng;
+    Xoshiro256& rng;
 
 public:
+    struct Checkpoint {
+        pair<int, int> position;
+        bool exists;
+    };
+
     /**
      * @brief Constructs a food manager with a random number generator.
      * @param rng Reference to random number generator
      */
-    FoodManager(mt19937& rng) : exists(false), rng(rng) {}
+    FoodManager(Xoshiro256& rng) : exists(false), rng(rng) {}
 
     /**
      * @brief Places food at a random empty location on the board.
      * @param board Reference to the game board
      */
-    void placeRandom(Board& board) {
-        vector<pair<int, int>> emptyCells = board.getEmptyCells();
+    template <typename BoardType>
+    void placeRandom(BoardType& board) {
+        int emptyCount = board.getEmptyCount();
         
-        if (emptyCells.empty()) {
+        if (emptyCount == 0) {
             exists = false;
             return;
         }
         
-        uniform_int_distribution<int> dist(0, emptyCells.size() - 1);
-        int idx = dist(rng);
-        position = emptyCells[idx];
+        position = board.getEmptyCell(static_cast<int>(rng.nextBounded(emptyCount)));
         board.setCellType(position.first, position.second, FOOD);
         exists = true;
     }
@@ -292,13 +915,30 @@ public:
      * @brief Removes the current food from the board.
      * @param board Reference to the game board
      */
-    void remove(Board& board) {
+    template <typename BoardType>
+    void remove(BoardType& board) {
         if (exists) {
             board.setCellType(position.first, position.second, EMPTY);
             exists = false;
         }
     }
 
+    /**
+     * @brief Copies the food position and presence, not the generator.
+     * @param other Food manager to copy
+     */
+    void copyFrom(const FoodManager& other) {
+        position = other.position;
+        exists = other.exists;
+    }
+
+    Checkpoint checkpoint() const { return {position, exists}; }
+
+    void rollback(const Checkpoint& checkpoint) {
+        position = checkpoint.position;
+        exists = checkpoint.exists;
+    }
+
     pair<int, int> getPosition() const { return position; }
     bool isPresent() const { return exists; }
 };
@@ -321,7 +961,8 @@ public:
      * @param board Reference to the game board
      * @return True if out of bounds, false otherwise
      */
-    static bool isOutOfBounds(pair<int, int> pos, const Board& board) {
+    template <typename BoardType>
+    static bool isOutOfBounds(pair<int, int> pos, const BoardType& board) {
         return !board.isInBounds(pos.first, pos.second);
     }
 
@@ -331,7 +972,8 @@ public:
      * @param board Reference to the game board
      * @return True if wall detected, false otherwise
      */
-    static bool isWall(pair<int, int> pos, const Board& board) {
+    template <typename BoardType>
+    static bool isWall(pair<int, int> pos, const BoardType& board) {
         return board.getCellType(pos.first, pos.second) == WALL;
     }
 
@@ -363,6 +1005,12 @@ private:
     atomic<int> atomicInput;
 
 public:
+    struct Checkpoint {
+        Direction current;
+        Direction next;
+        int input;
+    };
+
     DirectionController() : current(NONE), next(NONE) {
         atomicInput.store(static_cast<int>(NONE), memory_order_relaxed);
     }
@@ -426,70 +1074,382 @@ public:
         next = initialDir;
     }
 
+    /**
+     * @brief Copies directions and pending input from the owning thread.
+     * @param other Controller to copy
+     */
+    void copyFrom(const DirectionController& other) {
+        current = other.current;
+        next = other.next;
+        atomicInput.store(other.atomicInput.load(memory_order_relaxed), memory_order_relaxed);
+    }
+
+    Checkpoint checkpoint() const {
+        return {current, next, atomicInput.load(memory_order_relaxed)};
+    }
+
+    void rollback(const Checkpoint& checkpoint) {
+        current = checkpoint.current;
+        next = checkpoint.next;
+        atomicInput.store(checkpoint.input, memory_order_relaxed);
+    }
+
     Direction getCurrent() const { return current; }
 };
 
 // ============================================================================
-// STATE PUBLISHER
+// GAME RULES
 // ============================================================================
 
 /**
- * @brief Manages thread-safe publishing of game state snapshots.
+ * @brief Applies one tick of the game rules to a set of components.
  * 
- * Uses double buffering and atomic operations to provide lock-free
- * state updates between game logic and rendering threads.
+ * Shared by SnakeGameLogic and FixedSnakeGameLogic so that both engines
+ * follow exactly the same rules regardless of how the board is stored.
  */
-class StatePublisher {
-private:
-    atomic<shared_ptr<const GameState>> currentState;
-    shared_ptr<GameState> writeBuffer;
-    shared_ptr<GameState> readBuffer;
-
+class GameRules {
 public:
-    StatePublisher() {
-        writeBuffer = make_shared<GameState>();
-        readBuffer = make_shared<GameState>();
-        currentState.store(writeBuffer, memory_order_relaxed);
-    }
-
     /**
-     * @brief Publishes a new game state snapshot.
-     * @param board Game board
+     * @brief Advances the game by one tick.
+     * @param board Game board (Board or FixedBoard)
      * @param snake Snake entity
      * @param foodManager Food manager
-     * @param score Current score
-     * @param gameOver Game over flag
+     * @param directionController Direction controller holding pending input
+     * @param score Score, increased when food is eaten
+     * @param pointsPerFood Points awarded per food
+     * @return NOT_OVER if the game continues, otherwise why it ended
      */
-    void publish(const Board& board, const Snake& snake, const FoodManager& foodManager, 
-                 int score, bool gameOver) {
-        writeBuffer->rows = board.getRows();
-        writeBuffer->cols = board.getCols();
-        writeBuffer->score = score;
-        writeBuffer->gameOver = gameOver;
-        writeBuffer->food = foodManager.getPosition();
-        writeBuffer->foodExists = foodManager.isPresent();
-        writeBuffer->snake = snake.getBody();
-        writeBuffer->snakeLength = snake.getLength();
-        writeBuffer->board = board.getGrid();
+    template <typename BoardType>
+    static GameOverReason tick(BoardType& board, Snake& snake, FoodManager& foodManager,
+                     DirectionController& directionController, int& score, int pointsPerFood) {
+        // Process direction input
+        directionController.processInput();
         
-        // Atomic swap with memory_order_release ensures visibility
-        currentState.store(writeBuffer, memory_order_release);
-        swap(writeBuffer, readBuffer);
-    }
-
-    /**
-     * @brief Gets the current game state (thread-safe).
-     * @return Shared pointer to immutable game state
-     */
-    shared_ptr<const GameState> getState() const {
-        return currentState.load(memory_order_acquire);
-    }
-};
-
+        // Calculate next position
+        pair<int, int> newHead = directionController.getNextPosition(snake.getHead());
+        
+        // Check collisions
+        if (CollisionDetector::isOutOfBounds(newHead, board)) {
+            return OUT_OF_BOUNDS;
+        }
+        
+        if (CollisionDetector::isWall(newHead, board)) {
+            return HIT_WALL;
+        }
+        
+        if (snake.checkSelfCollision(newHead, board)) {
+            return HIT_SELF;
+        }
+        
+        // Handle food collision
+        if (CollisionDetector::isFood(newHead, foodManager)) {
+            snake.grow();
+            score += pointsPerFood;
+            foodManager.remove(board);
+        }
+        
+        // Move snake
+        snake.move(newHead, board);
+        
+        // Place new food if needed
+        if (!foodManager.isPresent()) {
+            foodManager.placeRandom(board);
+        }
+        
+        // Check win condition (board full)
+        if (!foodManager.isPresent() && !snake.hasPendingGrowth()) {
+            return BOARD_FULL;
+        }
+        return NOT_OVER;
+    }
+};
+
+// ============================================================================
+// STATE PUBLISHER
+// ============================================================================
+
+/**
+ * @brief Snapshot buffer owned by the StatePublisher.
+ * 
+ * Readers pin a slot while they look at it; the writer never reuses a
+ * pinned slot or the currently published one.
+ */
+struct StateSlot {
+    GameState state{};
+    atomic<int> pins{0};
+};
+
+/**
+ * @brief Read-only handle to a published snapshot.
+ * 
+ * Keeps its slot pinned until destroyed, so the snapshot cannot be
+ * overwritten while the view is alive. Views should be short-lived: each
+ * live view holds back one publisher slot.
+ */
+class StateView {
+private:
+    StateSlot* slot;
+
+public:
+    StateView() : slot(nullptr) {}
+    explicit StateView(StateSlot* slot) : slot(slot) {}
+    StateView(StateView&& other) noexcept : slot(other.slot) { other.slot = nullptr; }
+    StateView(const StateView&) = delete;
+    StateView& operator=(const StateView&) = delete;
+
+    StateView& operator=(StateView&& other) noexcept {
+        if (this != &other) {
+            release();
+            slot = other.slot;
+            other.slot = nullptr;
+        }
+        return *this;
+    }
+
+    ~StateView() { release(); }
+
+    /**
+     * @brief Unpins the snapshot early.
+     */
+    void release() {
+        if (slot) {
+            slot->pins.fetch_sub(1, memory_order_release);
+            slot = nullptr;
+        }
+    }
+
+    const GameState* get() const { return &slot->state; }
+    const GameState* operator->() const { return &slot->state; }
+    const GameState& operator*() const { return slot->state; }
+    explicit operator bool() const { return slot != nullptr; }
+};
+
+/**
+ * @brief Manages thread-safe publishing of game state snapshots.
+ * 
+ * Keeps a small fixed set of snapshot slots and publishes by storing the
+ * index of the freshly written slot. The writer is wait-free: it writes
+ * into any slot that is neither published nor pinned, which always exists
+ * while no more than maxReaders views are alive at once (otherwise the
+ * publish is skipped and readers keep the previous snapshot). Readers pin a
+ * slot with one atomic increment, with no shared_ptr refcount traffic and
+ * no locks.
+ * 
+ * In delta mode a publish costs O(changed cells) instead of
+ * O(rows * cols + length): the slot being written is brought up to date by
+ * replaying the change lists of the ticks it missed, and the snake body is
+ * reduced to its head. Slots that fell too far behind are fully copied.
+ */
+class StatePublisher {
+private:
+    static constexpr int HistoryLength = 16;
+
+    unique_ptr<StateSlot[]> slots;
+    int slotCount;
+    atomic<int> currentSlot;
+    array<vector<CellChange>, HistoryLength> history;   ///< Change lists by sequence % HistoryLength
+    uint64_t sequence;
+    uint64_t fullSnapshotFloor;     ///< Slots written before this sequence need a full copy
+    bool deltaMode;
+
+    uint64_t allocationCount;       ///< Times a snapshot buffer had to grow while publishing
+
+    static void applyChanges(GameState& state, const vector<CellChange>& changes) {
+        for (const CellChange& change : changes) {
+            state.board[change.index] = change.newType;
+        }
+    }
+
+    /**
+     * @brief Notes whether storing a number of elements will reallocate.
+     * @param buffer Destination buffer
+     * @param size Number of elements about to be stored
+     */
+    template <typename T>
+    void countGrowth(const vector<T>& buffer, size_t size) {
+        if (size > buffer.capacity()) allocationCount++;
+    }
+
+    /**
+     * @brief Picks a slot that no reader can be looking at.
+     * 
+     * Among free slots the most recently written one is preferred, since it
+     * needs the fewest changes replayed in delta mode.
+     * @return Slot index, or -1 if every spare slot is pinned
+     */
+    int findWritableSlot() const {
+        int current = currentSlot.load(memory_order_relaxed);
+        int best = -1;
+        for (int i = 0; i < slotCount; i++) {
+            if (i == current || slots[i].pins.load(memory_order_seq_cst) != 0) continue;
+            if (best < 0 || slots[i].state.sequence > slots[best].state.sequence) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+public:
+    /**
+     * @brief Creates a publisher with enough slots for concurrent readers.
+     * @param maxReaders Number of StateViews that may be alive at the same time
+     */
+    explicit StatePublisher(int maxReaders = 2)
+        : slotCount(maxReaders + 2), currentSlot(0), sequence(0),
+          fullSnapshotFloor(1), deltaMode(false), allocationCount(0) {
+        slots = make_unique<StateSlot[]>(slotCount);
+    }
+
+    /**
+     * @brief Preallocates every snapshot buffer for a board size.
+     * 
+     * After this, publishing never allocates: boards and snakes are sized
+     * for rows * cols and change lists for a tick's worth of changes.
+     * Buffers already large enough are left alone, so calling this on every
+     * game start costs nothing after the first.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     */
+    void reserve(int rows, int cols) {
+        size_t cellCount = static_cast<size_t>(rows) * cols;
+        for (int i = 0; i < slotCount; i++) {
+            GameState& state = slots[i].state;
+            state.board.reserve(cellCount);
+            state.snake.reserve(cellCount);
+            state.changes.reserve(8);
+        }
+        for (vector<CellChange>& changes : history) {
+            changes.reserve(8);
+        }
+    }
+
+    /**
+     * @brief Gets how often publishing had to grow a snapshot buffer.
+     * 
+     * Stays constant in steady-state play once reserve() was called for the
+     * board size; a rising count means publish() is allocating.
+     * @return Number of buffer growths since construction
+     */
+    uint64_t getAllocationCount() const {
+        return allocationCount;
+    }
+
+    /**
+     * @brief Switches between full-copy and delta publishing.
+     * @param enabled True to publish deltas
+     */
+    void setDeltaMode(bool enabled) {
+        deltaMode = enabled;
+        requestFullSnapshot();
+    }
+
+    /**
+     * @brief Forces the next publishes to copy the whole board and snake.
+     * 
+     * Needed whenever the board changed without its changes being published,
+     * e.g. after re-initialization. One sequence number is skipped so that
+     * incremental consumers see a gap and resynchronize from the full board.
+     */
+    void requestFullSnapshot() {
+        sequence++;
+        fullSnapshotFloor = sequence + 1;
+    }
+
+    /**
+     * @brief Publishes a new game state snapshot.
+     * @param board Game board; in delta mode it must track changes, and its
+     *              change log must hold exactly the changes since the last publish
+     * @param snake Snake entity
+     * @param foodManager Food manager
+     * @param score Current score
+     * @param gameOver Game over flag
+     */
+    void publish(const Board& board, const Snake& snake, const FoodManager& foodManager, 
+                 int score, bool gameOver) {
+        sequence++;
+        vector<CellChange>& tickChanges = history[sequence % HistoryLength];
+        countGrowth(tickChanges, board.getChanges().size());
+        tickChanges = board.getChanges();
+        
+        int target = findWritableSlot();
+        if (target < 0) {
+            return;
+        }
+        
+        GameState& state = slots[target].state;
+        bool canCatchUp = deltaMode && state.sequence >= fullSnapshotFloor &&
+                          sequence - state.sequence <= HistoryLength;
+        
+        state.rows = board.getRows();
+        state.cols = board.getCols();
+        state.score = score;
+        state.gameOver = gameOver;
+        state.food = foodManager.getPosition();
+        state.foodExists = foodManager.isPresent();
+        state.snakeLength = snake.getLength();
+        state.changesTracked = deltaMode;
+        countGrowth(state.changes, tickChanges.size());
+        state.changes = tickChanges;
+        
+        if (canCatchUp) {
+            for (uint64_t missed = state.sequence + 1; missed <= sequence; missed++) {
+                applyChanges(state, history[missed % HistoryLength]);
+            }
+            state.snake.resize(1);
+            state.snake[0] = PackedCell::fromPosition(snake.getHead());
+        } else {
+            countGrowth(state.snake, snake.getLength());
+            countGrowth(state.board, board.getCells().size());
+            snake.getBody().copyTo(state.snake);
+            state.board = board.getCells();
+        }
+        state.sequence = sequence;
+        
+        // Publishing the slot index makes the finished snapshot visible
+        currentSlot.store(target, memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Gets the current game state (thread-safe).
+     * 
+     * Pins the published slot, then re-checks that it is still the
+     * published one; if the writer moved on in between, the slot may be
+     * getting rewritten, so the pin is dropped and the read retried.
+     * @return Pinned view of the latest snapshot
+     */
+    StateView getState() const {
+        while (true) {
+            int index = currentSlot.load(memory_order_seq_cst);
+            slots[index].pins.fetch_add(1, memory_order_seq_cst);
+            if (currentSlot.load(memory_order_seq_cst) == index) {
+                return StateView(&slots[index]);
+            }
+            slots[index].pins.fetch_sub(1, memory_order_release);
+        }
+    }
+};
+
 // ============================================================================
 // MAIN GAME LOGIC
 // ============================================================================
 
+/**
+ * @brief Caller-owned save point for SnakeGameLogic::saveTo()/restoreFrom().
+ * 
+ * Holds only fixed-size state (about 100 bytes); board and body changes
+ * made after the save are kept in the game's undo journals.
+ */
+struct GameCheckpoint {
+    Xoshiro256 rng;
+    size_t boardJournalSize = 0;
+    Snake::Checkpoint snake{};
+    FoodManager::Checkpoint food{};
+    DirectionController::Checkpoint direction{};
+    int score = 0;
+    bool gameOver = false;
+    GameOverReason gameOverReason = NOT_OVER;
+};
+
 /**
  * @brief Main game logic controller coordinating all game systems.
  * 
@@ -499,21 +1459,42 @@ public:
  */
 class SnakeGameLogic {
 private:
+    Xoshiro256 rng;                 ///< Declared first: foodManager keeps a reference
     Board board;
     Snake snake;
     FoodManager foodManager;
     DirectionController directionController;
     StatePublisher statePublisher;
     
-    mt19937 rng;
     int score;
     int pointsPerFood;
     bool gameOver;
+    GameOverReason gameOverReason;
+    bool publishing;
 
 public:
-    SnakeGameLogic() : foodManager(rng), score(0), pointsPerFood(10), gameOver(false) {
-        auto seed = chrono::high_resolution_clock::now().time_since_epoch().count();
-        rng.seed(static_cast<unsigned int>(seed));
+    /**
+     * @brief Creates a game seeded from the clock, for interactive play.
+     */
+    SnakeGameLogic()
+        : SnakeGameLogic(static_cast<uint64_t>(chrono::high_resolution_clock::now().time_since_epoch().count())) {}
+
+    /**
+     * @brief Creates a reproducible game.
+     * @param seed Seed for food placement
+     * @param stream Stream index, e.g. the game's index in a parallel batch
+     */
+    explicit SnakeGameLogic(uint64_t seed, uint64_t stream = 0)
+        : rng(seed, stream), foodManager(rng), score(0), pointsPerFood(10), gameOver(false),
+          gameOverReason(NOT_OVER), publishing(true) {}
+
+    /**
+     * @brief Reseeds food placement; takes effect from the next placement.
+     * @param seed Seed for food placement
+     * @param stream Stream index, e.g. the game's index in a parallel batch
+     */
+    void setSeed(uint64_t seed, uint64_t stream = 0) {
+        rng.seed(seed, stream);
     }
 
     /**
@@ -529,15 +1510,147 @@ public:
         this->pointsPerFood = pointsPerFood;
         score = 0;
         gameOver = false;
+        gameOverReason = NOT_OVER;
         
         board.initialize(rows, cols);
         directionController.initialize(initialDirection);
+        statePublisher.reserve(rows, cols);
         
         pair<int, int> startPos = {rows / 2, cols / 2};
         snake.initialize(startPos, startingLength, initialDirection, board);
         
         foodManager.placeRandom(board);
-        statePublisher.publish(board, snake, foodManager, score, gameOver);
+        if (publishing) {
+            statePublisher.requestFullSnapshot();
+            statePublisher.publish(board, snake, foodManager, score, gameOver);
+        }
+        board.clearChanges();
+    }
+
+    /**
+     * @brief Switches the state publisher between full and delta snapshots.
+     * 
+     * Delta snapshots carry the tick's cell changes and a sequence number,
+     * making each publish O(1) for consumers that apply changes incrementally.
+     * @param enabled True to publish deltas
+     */
+    void setDeltaPublishing(bool enabled) {
+        board.setChangeTracking(enabled);
+        statePublisher.setDeltaMode(enabled);
+    }
+
+    /**
+     * @brief Turns snapshot publishing in update() on or off.
+     * 
+     * With publishing off, update() only runs the rules; read the game
+     * through the game-thread accessors, since getGameState() and the
+     * other thread-safe accessors keep returning the last published state.
+     * Turning it back on publishes a full snapshot right away.
+     * @param enabled True to publish after every update()
+     */
+    void setPublishing(bool enabled) {
+        publishing = enabled;
+        if (enabled) {
+            statePublisher.requestFullSnapshot();
+            statePublisher.publish(board, snake, foodManager, score, gameOver);
+            board.clearChanges();
+        }
+    }
+
+    /**
+     * @brief Copies the game state into another game, reusing its buffers.
+     * 
+     * Copies the board, body, food, direction, score and generator, so the
+     * target plays on exactly like this game would. Nothing mutable is
+     * shared, the publisher is skipped, and the target has publishing off,
+     * change tracking off and no checkpoints.
+     * @param target Game to overwrite
+     */
+    void copyStateTo(SnakeGameLogic& target) const {
+        target.rng = rng;
+        target.board.copyFrom(board);
+        target.snake.copyFrom(snake);
+        target.foodManager.copyFrom(foodManager);
+        target.directionController.copyFrom(directionController);
+        target.statePublisher.setDeltaMode(false);
+        target.score = score;
+        target.pointsPerFood = pointsPerFood;
+        target.gameOver = gameOver;
+        target.gameOverReason = gameOverReason;
+        target.publishing = false;
+    }
+
+    /**
+     * @brief Creates an independent copy for lookahead (see copyStateTo()).
+     * @return Game with publishing off
+     */
+    unique_ptr<SnakeGameLogic> clone() const {
+        auto copy = make_unique<SnakeGameLogic>(uint64_t(0));
+        copyStateTo(*copy);
+        return copy;
+    }
+
+    /**
+     * @brief Saves the current state into a caller-supplied checkpoint.
+     * 
+     * Turns on undo journaling for the board and body, so the save itself
+     * is O(1) and restoreFrom() costs O(changes since the save). Checkpoints
+     * nest: restoring one invalidates those saved after it.
+     * initializeBoard() and clearCheckpoints() invalidate all of them.
+     * @param checkpoint Buffer to fill
+     */
+    void saveTo(GameCheckpoint& checkpoint) {
+        if (!board.isJournaling()) {
+            board.setJournaling(true);
+            snake.setJournaling(true);
+        }
+        checkpoint.rng = rng;
+        checkpoint.boardJournalSize = board.getJournalSize();
+        checkpoint.snake = snake.checkpoint();
+        checkpoint.food = foodManager.checkpoint();
+        checkpoint.direction = directionController.checkpoint();
+        checkpoint.score = score;
+        checkpoint.gameOver = gameOver;
+        checkpoint.gameOverReason = gameOverReason;
+    }
+
+    /**
+     * @brief Returns to a checkpoint by undoing the journaled changes.
+     * 
+     * The checkpoint stays valid, so a search can restore it once per
+     * simulated line. With publishing on, a full snapshot is published.
+     * @param checkpoint Filled by saveTo() on this game
+     */
+    void restoreFrom(const GameCheckpoint& checkpoint) {
+        board.rollback(checkpoint.boardJournalSize);
+        snake.rollback(checkpoint.snake);
+        foodManager.rollback(checkpoint.food);
+        directionController.rollback(checkpoint.direction);
+        rng = checkpoint.rng;
+        score = checkpoint.score;
+        gameOver = checkpoint.gameOver;
+        gameOverReason = checkpoint.gameOverReason;
+        if (publishing) {
+            board.clearChanges();
+            statePublisher.requestFullSnapshot();
+            statePublisher.publish(board, snake, foodManager, score, gameOver);
+        }
+    }
+
+    /**
+     * @brief Drops every checkpoint and stops journaling.
+     */
+    void clearCheckpoints() {
+        board.setJournaling(false);
+        snake.setJournaling(false);
+    }
+
+    /**
+     * @brief Gets how often publishing had to grow a snapshot buffer.
+     * @return Number of buffer growths; constant during steady-state play
+     */
+    uint64_t getSnapshotAllocationCount() const {
+        return statePublisher.getAllocationCount();
     }
 
     /**
@@ -557,63 +1670,42 @@ public:
             return false;
         }
         
-        // Process direction input
-        directionController.processInput();
-        
-        // Calculate next position
-        pair<int, int> newHead = directionController.getNextPosition(snake.getHead());
+        gameOverReason = GameRules::tick(board, snake, foodManager, directionController,
+                                         score, pointsPerFood);
+        gameOver = gameOverReason != NOT_OVER;
         
-        // Check collisions
-        if (CollisionDetector::isOutOfBounds(newHead, board)) {
-            gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
-            return false;
-        }
-        
-        if (CollisionDetector::isWall(newHead, board)) {
-            gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
-            return false;
-        }
-        
-        if (snake.checkSelfCollision(newHead)) {
-            gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
-            return false;
-        }
-        
-        // Handle food collision
-        if (CollisionDetector::isFood(newHead, foodManager)) {
-            snake.grow();
-            score += pointsPerFood;
-            foodManager.remove(board);
-        }
-        
-        // Move snake
-        snake.move(newHead, board);
-        
-        // Place new food if needed
-        if (!foodManager.isPresent()) {
-            foodManager.placeRandom(board);
-        }
-        
-        // Check win condition (board full)
-        if (!foodManager.isPresent() && !snake.hasPendingGrowth()) {
-            gameOver = true;
+        // Publish updated state
+        if (publishing) {
             statePublisher.publish(board, snake, foodManager, score, gameOver);
-            return false;
         }
-        
-        // Publish updated state
-        statePublisher.publish(board, snake, foodManager, score, gameOver);
-        return true;
+        board.clearChanges();
+        return !gameOver;
     }
 
+    // ========================================================================
+    // GAME-THREAD ACCESSORS (for bots and tools driving update() directly)
+    // ========================================================================
+
+    const Board& getBoard() const { return board; }
+    const Snake& getSnake() const { return snake; }
+    const FoodManager& getFoodManager() const { return foodManager; }
+    Direction getCurrentDirection() const { return directionController.getCurrent(); }
+    GameOverReason getGameOverReason() const { return gameOverReason; }
+    int getCurrentScore() const { return score; }
+    bool hasEnded() const { return gameOver; }
+    bool isPublishing() const { return publishing; }
+
+    /**
+     * @brief Subscribes a listener to the board's cell transitions.
+     * @param listener Listener such as a DistanceField, or nullptr to detach
+     */
+    void setBoardListener(CellChangeListener* listener) { board.setChangeListener(listener); }
+
     // ========================================================================
     // THREAD-SAFE ACCESSORS (for render thread)
     // ========================================================================
 
-    shared_ptr<const GameState> getGameState() const {
+    StateView getGameState() const {
         return statePublisher.getState();
     }
 
@@ -640,7 +1732,7 @@ public:
     int getCellType(int r, int c) const {
         auto state = statePublisher.getState();
         if (r >= 0 && r < state->rows && c >= 0 && c < state->cols) {
-            return state->board[r][c];
+            return state->cellAt(r, c);
         }
         return WALL;
     }
@@ -667,4 +1759,111 @@ public:
     static Direction getDirectionRight() { return RIGHT; }
 };
 
+// ============================================================================
+// FIXED-SIZE GAME LOGIC
+// ============================================================================
+
+/**
+ * @brief Game logic for board sizes known at compile time.
+ * 
+ * Runs the same GameRules as SnakeGameLogic on a FixedBoard, so bounds
+ * checks and index math use constant dimensions and the board lives inline
+ * instead of on the heap. Intended for fixed tournament sizes and headless
+ * simulation: state is read directly on the game thread and no snapshots
+ * are published. Use SnakeGameLogic for arbitrary GameConfig sizes.
+ * @tparam Rows Number of rows
+ * @tparam Cols Number of columns
+ */
+template <int Rows, int Cols>
+class FixedSnakeGameLogic {
+private:
+    Xoshiro256 rng;                 ///< Declared first: foodManager keeps a reference
+    FixedBoard<Rows, Cols> board;
+    Snake snake;
+    FoodManager foodManager;
+    DirectionController directionController;
+    
+    int score;
+    int pointsPerFood;
+    bool gameOver;
+    GameOverReason gameOverReason;
+
+public:
+    /**
+     * @brief Creates a game seeded from the clock, for interactive play.
+     */
+    FixedSnakeGameLogic()
+        : FixedSnakeGameLogic(static_cast<uint64_t>(chrono::high_resolution_clock::now().time_since_epoch().count())) {}
+
+    /**
+     * @brief Creates a reproducible game.
+     * @param seed Seed for food placement
+     * @param stream Stream index, e.g. the game's index in a parallel batch
+     */
+    explicit FixedSnakeGameLogic(uint64_t seed, uint64_t stream = 0)
+        : rng(seed, stream), foodManager(rng), score(0), pointsPerFood(10), gameOver(false),
+          gameOverReason(NOT_OVER) {}
+
+    /**
+     * @brief Reseeds food placement; takes effect from the next placement.
+     * @param seed Seed for food placement
+     * @param stream Stream index, e.g. the game's index in a parallel batch
+     */
+    void setSeed(uint64_t seed, uint64_t stream = 0) {
+        rng.seed(seed, stream);
+    }
+
+    /**
+     * @brief Initializes the game with specified parameters.
+     * @param startingLength Initial snake length
+     * @param pointsPerFood Points awarded per food
+     * @param initialDirection Starting movement direction
+     */
+    void initializeBoard(int startingLength, int pointsPerFood, Direction initialDirection) {
+        this->pointsPerFood = pointsPerFood;
+        score = 0;
+        gameOver = false;
+        gameOverReason = NOT_OVER;
+        
+        board.initialize();
+        directionController.initialize(initialDirection);
+        snake.initialize({Rows / 2, Cols / 2}, startingLength, initialDirection, board);
+        foodManager.placeRandom(board);
+    }
+
+    /**
+     * @brief Sets the snake direction (thread-safe input).
+     * @param newDir Direction to move
+     */
+    void setDirection(Direction newDir) {
+        directionController.setInput(newDir);
+    }
+
+    /**
+     * @brief Updates the game state by one tick.
+     * @return True if game continues, false if game over
+     */
+    bool update() {
+        if (gameOver) {
+            return false;
+        }
+        
+        gameOverReason = GameRules::tick(board, snake, foodManager, directionController,
+                                         score, pointsPerFood);
+        gameOver = gameOverReason != NOT_OVER;
+        return !gameOver;
+    }
+
+    int getCellType(int r, int c) const { return board.getCellType(r, c); }
+    int getScore() const { return score; }
+    bool isGameOver() const { return gameOver; }
+    GameOverReason getGameOverReason() const { return gameOverReason; }
+    const FixedBoard<Rows, Cols>& getBoard() const { return board; }
+    const Snake& getSnake() const { return snake; }
+    const FoodManager& getFoodManager() const { return foodManager; }
+    Direction getCurrentDirection() const { return directionController.getCurrent(); }
+    static constexpr int getRows() { return Rows; }
+    static constexpr int getCols() { return Cols; }
+};
+
 #endif // GAMELOGIC_H
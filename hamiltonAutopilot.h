@@ -0,0 +1,277 @@
+// hamiltonAutopilot.h
+#ifndef HAMILTONAUTOPILOT_H
+#define HAMILTONAUTOPILOT_H
+
+#include "bfsAutopilot.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+// ============================================================================
+// HAMILTONIAN CYCLE
+// ============================================================================
+
+/**
+ * @brief A closed path through every cell of a rows x cols board.
+ *
+ * Stored as two flat tables: the cell after each cell on the cycle, and
+ * each cell's position along it. A cycle exists when both sides are at
+ * least 2 and one of them is even; otherwise the tables stay empty. The
+ * reversed cycle runs through the same cells in the opposite direction.
+ *
+ * Tables are immutable once built and shared through forBoard(), so every
+ * game on a board size after the first starts without rebuilding them.
+ */
+class HamiltonCycle {
+private:
+    int rows;
+    int cols;
+    vector<int32_t> nextCell;       ///< Flat index -> flat index of the next cell
+    vector<int32_t> order;          ///< Flat index -> position along the cycle
+
+    /**
+     * @brief Builds the cycle for an even number of rows.
+     *
+     * Runs right along row 0, snakes back and forth over columns 1..C-1 of
+     * the remaining rows (ending at column 1 of the last row, since their
+     * count is odd) and returns up column 0. With transposed set, the same
+     * walk is laid over the board's columns instead.
+     */
+    void build(int evenSide, int otherSide, bool transposed, bool reversed) {
+        vector<int32_t> path;
+        path.reserve(rows * cols);
+        auto visit = [&](int r, int c) {
+            path.push_back(transposed ? c * cols + r : r * cols + c);
+        };
+        for (int c = 0; c < otherSide; c++) visit(0, c);
+        for (int r = 1; r < evenSide; r++) {
+            if (r % 2 == 1) {
+                for (int c = otherSide - 1; c >= 1; c--) visit(r, c);
+            } else {
+                for (int c = 1; c < otherSide; c++) visit(r, c);
+            }
+        }
+        for (int r = evenSide - 1; r >= 1; r--) visit(r, 0);
+        if (reversed) reverse(path.begin(), path.end());
+
+        int cellCount = static_cast<int>(path.size());
+        nextCell.resize(cellCount);
+        order.resize(cellCount);
+        for (int i = 0; i < cellCount; i++) {
+            nextCell[path[i]] = path[(i + 1) % cellCount];
+            order[path[i]] = i;
+        }
+    }
+
+public:
+    HamiltonCycle(int rows, int cols, bool reversed = false) : rows(rows), cols(cols) {
+        if (rows < 2 || cols < 2) return;
+        if (rows % 2 == 0) {
+            build(rows, cols, false, reversed);
+        } else if (cols % 2 == 0) {
+            build(cols, rows, true, reversed);
+        }
+    }
+
+    /**
+     * @brief Gets the shared cycle for a board size, building it on first use.
+     *
+     * Thread-safe; concurrent games of one size share a single table.
+     */
+    static shared_ptr<const HamiltonCycle> forBoard(int rows, int cols, bool reversed = false) {
+        static mutex cacheMutex;
+        static map<tuple<int, int, bool>, shared_ptr<const HamiltonCycle>> cache;
+        lock_guard<mutex> lock(cacheMutex);
+        shared_ptr<const HamiltonCycle>& cycle = cache[{rows, cols, reversed}];
+        if (!cycle) {
+            cycle = make_shared<const HamiltonCycle>(rows, cols, reversed);
+        }
+        return cycle;
+    }
+
+    bool exists() const { return !nextCell.empty(); }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getLength() const { return static_cast<int>(nextCell.size()); }
+    int next(int index) const { return nextCell[index]; }
+    int position(int index) const { return order[index]; }
+
+    /**
+     * @brief Gets how many steps along the cycle lead from one cell to another.
+     */
+    int distance(int from, int to) const {
+        int steps = order[to] - order[from];
+        return steps < 0 ? steps + getLength() : steps;
+    }
+};
+
+// ============================================================================
+// HAMILTONIAN CYCLE AUTOPILOT
+// ============================================================================
+
+/**
+ * @brief Follows a Hamiltonian cycle, cutting ahead when the cycle order
+ *        proves it safe, so it can fill the whole board.
+ *
+ * While the snake's segments lie in cycle order from tail to head, every
+ * cell after the head and before the tail is empty. Moving to any such
+ * cell keeps the segments ordered, so the snake may jump ahead along the
+ * cycle as long as it stays short of the tail; it never jumps past the
+ * food, since that cell would only come round again a full lap later.
+ *
+ * The body is checked against the cycle order (O(length)) only until it
+ * lines up, and again whenever the head is not where the last decision
+ * sent it. Both directions of the cycle are tried, so a straight starting
+ * body that runs against the cycle is aligned from the first tick. A
+ * starting body hanging off a narrow board is aligned once its off-board
+ * segments drop off; until then the snake follows the direction with the
+ * most room. Boards without a cycle (both sides odd) are played by a
+ * BfsAutopilot.
+ */
+class HamiltonAutopilot : public Autopilot {
+private:
+    shared_ptr<const HamiltonCycle> cycle;          ///< Direction in use
+    shared_ptr<const HamiltonCycle> directions[2];  ///< Forward and reversed cycle
+    BfsAutopilot fallback;
+    bool aligned;                   ///< Body known to lie in cycle order
+    int expectedHead;               ///< Cell the last decision moved to, or -1
+
+    /**
+     * @brief Finds the last body segment on the board.
+     *
+     * Segments Snake::initialize() left off the board trail the body and
+     * are not on the cycle.
+     * @return Body index of the on-board tail
+     */
+    static int boardTail(const SnakeGameLogic& game) {
+        const SnakeBody& body = game.getSnake().getBody();
+        const Board& board = game.getBoard();
+        int last = static_cast<int>(body.size()) - 1;
+        while (last > 0 && !board.isInBounds(body[last].first, body[last].second)) last--;
+        return last;
+    }
+
+    /**
+     * @brief Checks whether body segments 0..last lie in cycle order from
+     *        segment last to the head.
+     */
+    static bool isAligned(const SnakeGameLogic& game, const HamiltonCycle& cycle, int last) {
+        const SnakeBody& body = game.getSnake().getBody();
+        const Board& board = game.getBoard();
+        pair<int, int> tailPos = body[last];
+        int tail = board.indexOf(tailPos.first, tailPos.second);
+        int previous = 0;
+        for (int i = last - 1; i >= 0; i--) {
+            pair<int, int> segment = body[i];
+            if (!board.isInBounds(segment.first, segment.second)) return false;
+            int steps = cycle.distance(tail, board.indexOf(segment.first, segment.second));
+            if (steps <= previous) return false;
+            previous = steps;
+        }
+        return true;
+    }
+
+    static Direction directionTo(int from, int to, int cols) {
+        if (to == from - cols) return UP;
+        if (to == from + cols) return DOWN;
+        return to == from - 1 ? LEFT : RIGHT;
+    }
+
+public:
+    HamiltonAutopilot() : aligned(false), expectedHead(-1) {}
+
+    Direction decide(const SnakeGameLogic& game) override {
+        const Board& board = game.getBoard();
+        int rows = board.getRows();
+        int cols = board.getCols();
+        if (!cycle || cycle->getRows() != rows || cycle->getCols() != cols) {
+            directions[0] = HamiltonCycle::forBoard(rows, cols);
+            directions[1] = HamiltonCycle::forBoard(rows, cols, true);
+            cycle = directions[0];
+            aligned = false;
+        }
+        if (!cycle->exists()) return fallback.decide(game);
+
+        const Snake& snake = game.getSnake();
+        pair<int, int> headPos = snake.getHead();
+        int head = board.indexOf(headPos.first, headPos.second);
+        if (head != expectedHead) aligned = false;
+        if (!aligned) {
+            // Take a direction the on-board body lines up with and whose next
+            // cell is free, preferring the most room before the on-board
+            // tail. While off-board segments remain, that tail stays put, so
+            // follow the cycle without cutting ahead until they drop off.
+            int last = boardTail(game);
+            pair<int, int> tailPos = snake.getBody()[last];
+            int tail = board.indexOf(tailPos.first, tailPos.second);
+            const FoodManager& food = game.getFoodManager();
+            int foodCell = food.isPresent()
+                ? board.indexOf(food.getPosition().first, food.getPosition().second) : -1;
+            int bestRoom = -1;
+            for (const shared_ptr<const HamiltonCycle>& candidate : directions) {
+                // Food before the tail delays it one more tick
+                int room = candidate->distance(head, tail);
+                if (foodCell >= 0 && candidate->distance(head, foodCell) < room) room--;
+                Direction along = directionTo(head, candidate->next(head), cols);
+                if (room > bestRoom && MoveHelper::isSafe(game, along) &&
+                    isAligned(game, *candidate, last)) {
+                    bestRoom = room;
+                    cycle = candidate;
+                    aligned = last == static_cast<int>(snake.getLength()) - 1;
+                }
+            }
+        }
+
+        int step = cycle->next(head);
+        if (aligned && !snake.hasPendingGrowth() && game.getFoodManager().isPresent()) {
+            pair<int, int> tailPos = snake.getBody().back();
+            pair<int, int> foodPos = game.getFoodManager().getPosition();
+            int toTail = cycle->distance(head, board.indexOf(tailPos.first, tailPos.second));
+            int toFood = cycle->distance(head, board.indexOf(foodPos.first, foodPos.second));
+            int bestSteps = 1;
+            for (int d = 0; d < 4; d++) {
+                Direction dir = static_cast<Direction>(d);
+                if (!MoveHelper::isSafe(game, dir)) continue;
+                int neighbor = head + MoveHelper::rowDelta[d] * cols + MoveHelper::colDelta[d];
+                int steps = cycle->distance(head, neighbor);
+                if (steps > bestSteps && steps <= toFood && steps < toTail) {
+                    bestSteps = steps;
+                    step = neighbor;
+                }
+            }
+        }
+
+        Direction dir = directionTo(head, step, cols);
+        if (!aligned && !MoveHelper::isSafe(game, dir)) {
+            dir = fallback.decide(game);
+            if (dir == NONE) {
+                expectedHead = -1;
+                return dir;
+            }
+            pair<int, int> target = {headPos.first + MoveHelper::rowDelta[dir],
+                                     headPos.second + MoveHelper::colDelta[dir]};
+            expectedHead = board.isInBounds(target.first, target.second)
+                ? board.indexOf(target.first, target.second) : -1;
+            return dir;
+        }
+        expectedHead = step;
+        return dir;
+    }
+
+    void reset() override {
+        aligned = false;
+        expectedHead = -1;
+        fallback.reset();
+    }
+
+    string getName() const override { return "hamilton"; }
+
+    /**
+     * @brief Gets the cycle in use, or nullptr before the first decision.
+     */
+    const HamiltonCycle* getCycle() const { return cycle.get(); }
+};
+
+#endif // HAMILTONAUTOPILOT_H
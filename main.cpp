@@ -1,4 +1,10 @@
 #include "gameLogic.h"
+#include "autopilot.h"
+#include "mctsAutopilot.h"
+#include "bfsAutopilot.h"
+#include "hamiltonAutopilot.h"
+#include "rolloutRunner.h"
+#include "tournament.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -9,6 +15,10 @@
 #include <functional>
 #include <map>
 #include <vector>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <climits>
 
 #ifdef _WIN32
     #include <conio.h>
@@ -84,6 +94,7 @@ public:
     // Gameplay settings
     int updateDelay;
     int pointsPerFood;
+    string autopilot;               // Policy steering interactive games; empty for the keyboard
     
     // Display settings
     char snakeHeadChar;
@@ -376,17 +387,18 @@ public:
         for (int r = 0; r < state->rows; r++) {
             ostringstream rowBuffer;
             terminal.setCursorPosition(headerRows + r, 1);
+            const uint8_t* row = state->board.data() + r * state->cols;
             
             for (int c = 0; c < state->cols; c++) {
-                int cellType = state->board[r][c];
+                int cellType = row[c];
                 
                 switch(cellType) {
                     case 0: // EMPTY
                         rowBuffer << config.emptyChar;
                         break;
                     case 1: // SNAKE
-                        if (r == state->snake.front().first && 
-                            c == state->snake.front().second) {
+                        if (r == state->snake.front().row && 
+                            c == state->snake.front().col) {
                             rowBuffer << config.snakeHeadChar;
                         } else {
                             rowBuffer << config.snakeBodyChar;
@@ -530,6 +542,50 @@ public:
     }
 };
 
+// ============================================
+// Autopilot Factory
+// ============================================
+
+/**
+ * @brief Names accepted by createAutopilot(), in registration order.
+ */
+const vector<string> autopilotNames = {"random", "greedy", "bfs", "hamilton", "mcts"};
+
+/**
+ * @brief Checks a name without building the autopilot (MCTS allocates its
+ *        thread pool and node pool up front).
+ */
+bool isAutopilotName(const string& name) {
+    return find(autopilotNames.begin(), autopilotNames.end(), name) != autopilotNames.end();
+}
+
+/**
+ * @brief Creates an autopilot by name.
+ * @param name One of autopilotNames
+ * @param seed Seed for the policy's own randomness
+ * @param mcts Search limits used when name is "mcts"
+ * @return Autopilot, or nullptr for an unknown name
+ */
+unique_ptr<Autopilot> createAutopilot(const string& name, uint64_t seed, MctsConfig mcts) {
+    if (name == "random") {
+        return make_unique<RandomAutopilot>(seed);
+    }
+    if (name == "greedy") {
+        return make_unique<GreedyAutopilot>();
+    }
+    if (name == "bfs") {
+        return make_unique<BfsAutopilot>();
+    }
+    if (name == "hamilton") {
+        return make_unique<HamiltonAutopilot>();
+    }
+    if (name == "mcts") {
+        mcts.seed = seed;
+        return make_unique<MctsAutopilot>(mcts);
+    }
+    return nullptr;
+}
+
 // ============================================
 // Game Session Manager
 // ============================================
@@ -544,6 +600,19 @@ private:
     GameRenderer renderer;
     int currentUpdateDelay;
     int lastScore;
+    unique_ptr<Autopilot> autopilot;   // Steers instead of the keyboard when set
+    
+    /**
+     * @brief Lets the autopilot choose the move for the next tick.
+     * 
+     * Called right after a tick; the MCTS autopilot's budget is a fraction
+     * of updateDelay, so the move is set before the next tick is due.
+     */
+    void steer() {
+        if (autopilot) {
+            game.setDirection(autopilot->decide(game));
+        }
+    }
     
 public:
     GameSession(TerminalController& term, HighScoreManager& hsm, const GameConfig& cfg)
@@ -553,9 +622,23 @@ public:
         
         // Wire up event system
         highScoreManager.setEventManager(&eventManager);
+        if (!config.autopilot.empty()) {
+            autopilot = createAutopilot(config.autopilot,
+                                        static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count()),
+                                        MctsConfig::forUpdateDelay(config.updateDelay));
+        }
     }
     
+    /**
+     * @brief Starts a new game, reusing the board and snake buffers of the
+     *        previous one.
+     */
     void initialize() {
+        currentUpdateDelay = config.updateDelay;
+        lastScore = 0;
+        if (autopilot) {
+            autopilot->reset();
+        }
         game.initializeBoard(
             config.rows,
             config.cols,
@@ -588,6 +671,7 @@ public:
         input.clearBuffer();
         renderer.drawFullScreen(game, false);
         this_thread::sleep_for(chrono::milliseconds(50));
+        steer();
         
         // Game loop
         auto lastUpdate = chrono::steady_clock::now();
@@ -614,6 +698,9 @@ public:
                 
                 renderer.updateGameBoard(game);
                 lastUpdate = now;
+                if (gameActive) {
+                    steer();
+                }
             }
             
             this_thread::sleep_for(chrono::milliseconds(10));
@@ -649,14 +736,14 @@ private:
     GameConfig config;
     
 public:
-    SnakeGameApp() {}
+    explicit SnakeGameApp(const GameConfig& cfg = GameConfig()) : config(cfg) {}
     
     void run() {
         terminal.enableRawMode();
         
+        // One session serves every replay; initialize() resets it in place
+        GameSession session(terminal, highScoreManager, config);
         while (true) {
-            // Create game session
-            GameSession session(terminal, highScoreManager, config);
             session.initialize();
             
             bool replay = session.run();
@@ -674,12 +761,298 @@ public:
     }
 };
 
+// ============================================
+// Headless Simulation
+// ============================================
+
+class HeadlessOptions {
+public:
+    long long games;
+    long long maxTicksPerGame;
+    string policy;
+    unsigned int seed;
+    int threads;
+    
+    string tournament;              // Comma-separated strategies, or "all"; empty for one policy
+    string csvPath;                 // Tournament summary CSV; empty to skip
+    string gamesCsvPath;            // Tournament per-game CSV; empty to skip
+    
+    HeadlessOptions() : games(1000), maxTicksPerGame(0), policy("greedy"), seed(1), threads(1) {}
+};
+
+/**
+ * @brief Runs games back to back with no terminal, renderer or sleeps.
+ * 
+ * Drives SnakeGameLogic::update() as fast as possible with an Autopilot as
+ * the input policy, spread over a RolloutRunner's worker threads, and
+ * reports engine throughput, score distribution and how games ended.
+ */
+class HeadlessRunner {
+private:
+    GameConfig config;
+    HeadlessOptions options;
+    
+    static int percentile(const vector<int>& sorted, double fraction) {
+        size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[index];
+    }
+    
+public:
+    HeadlessRunner(const GameConfig& cfg, const HeadlessOptions& opts)
+        : config(cfg), options(opts) {}
+    
+    /**
+     * @brief Creates a policy; MCTS searches single-threaded with a fixed
+     *        iteration count, since the rollout workers already use the cores.
+     */
+    static unique_ptr<Autopilot> createPolicy(const string& name, uint64_t seed) {
+        MctsConfig mcts;
+        mcts.threads = 1;
+        mcts.maxIterations = 200;
+        mcts.nodeCapacity = 1 << 12;
+        return createAutopilot(name, seed, mcts);
+    }
+    
+    static RolloutConfig createRolloutConfig(const GameConfig& config, const HeadlessOptions& options) {
+        RolloutConfig rollout;
+        rollout.rows = config.rows;
+        rollout.cols = config.cols;
+        rollout.startingLength = config.startingLength;
+        rollout.pointsPerFood = config.pointsPerFood;
+        rollout.initialDirection = SnakeGameLogic::getDirectionRight();
+        rollout.maxTicksPerEpisode = options.maxTicksPerGame > 0
+            ? options.maxTicksPerGame
+            : 10LL * config.rows * config.cols;
+        rollout.seed = options.seed;
+        return rollout;
+    }
+    
+    int run() {
+        if (!isAutopilotName(options.policy)) {
+            cerr << "Unknown policy: " << options.policy << " (expected random, greedy, bfs, hamilton or mcts)\n";
+            return 1;
+        }
+        
+        RolloutConfig rollout = createRolloutConfig(config, options);
+        
+        string policyName = options.policy;
+        RolloutRunner runner(rollout, [&](uint64_t seed) {
+            return createPolicy(policyName, seed);
+        }, options.threads);
+        
+        auto start = chrono::steady_clock::now();
+        RolloutStats stats = runner.run(static_cast<uint32_t>(options.games));
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        
+        vector<int>& scores = stats.scores;
+        sort(scores.begin(), scores.end());
+        double meanScore = double(stats.totalScore) / max(stats.episodes, 1LL);
+        
+        ostringstream report;
+        report << fixed << setprecision(1);
+        report << "Headless run: " << options.games << " games, policy " << options.policy
+               << ", board " << config.rows << "x" << config.cols
+               << ", " << runner.getThreadCount() << " thread(s)\n";
+        report << "  Ticks:        " << stats.totalTicks << " in " << setprecision(3)
+               << elapsed.count() << " s" << setprecision(1) << "\n";
+        report << "  Ticks/sec:    " << stats.totalTicks / elapsed.count() << "\n";
+        report << "  Games/sec:    " << stats.episodes / elapsed.count() << "\n";
+        report << "  Capped games: " << stats.endings[NOT_OVER] << " (hit "
+               << rollout.maxTicksPerEpisode << " ticks)\n";
+        report << "  Endings:      out of bounds " << stats.endings[OUT_OF_BOUNDS]
+               << "  wall " << stats.endings[HIT_WALL]
+               << "  self " << stats.endings[HIT_SELF]
+               << "  board full " << stats.endings[BOARD_FULL] << "\n";
+        if (!scores.empty()) {
+            report << "  Score:        min " << scores.front()
+                   << "  p25 " << percentile(scores, 0.25)
+                   << "  median " << percentile(scores, 0.5)
+                   << "  p75 " << percentile(scores, 0.75)
+                   << "  p90 " << percentile(scores, 0.9)
+                   << "  max " << scores.back()
+                   << "  mean " << meanScore << "\n";
+        }
+        cout << report.str();
+        return 0;
+    }
+};
+
+// ============================================
+// Bot Tournament
+// ============================================
+
+/**
+ * @brief Plays several policies on the same seeds and compares them.
+ * 
+ * Uses the headless policies and board settings, prints a ranked table
+ * and optionally writes summary and per-game CSV files.
+ */
+class TournamentMode {
+private:
+    GameConfig config;
+    HeadlessOptions options;
+    
+    static vector<string> splitNames(const string& list) {
+        if (list == "all") return autopilotNames;
+        vector<string> names;
+        stringstream stream(list);
+        string name;
+        while (getline(stream, name, ',')) {
+            if (!name.empty()) names.push_back(name);
+        }
+        return names;
+    }
+    
+    static bool writeFile(const string& path, const function<void(ostream&)>& write) {
+        ofstream file(path);
+        if (!file.is_open()) {
+            cerr << "Cannot write " << path << "\n";
+            return false;
+        }
+        write(file);
+        return true;
+    }
+    
+public:
+    TournamentMode(const GameConfig& cfg, const HeadlessOptions& opts)
+        : config(cfg), options(opts) {}
+    
+    int run() {
+        vector<TournamentEntry> entries;
+        for (const string& name : splitNames(options.tournament)) {
+            if (!isAutopilotName(name)) {
+                cerr << "Unknown policy: " << name << " (expected all or a comma-separated list of "
+                     << "random, greedy, bfs, hamilton and mcts)\n";
+                return 1;
+            }
+            entries.push_back({name, [name](uint64_t seed) {
+                return HeadlessRunner::createPolicy(name, seed);
+            }});
+        }
+        if (entries.empty()) {
+            cerr << "No policies to compare\n";
+            return 1;
+        }
+        
+        TournamentRunner runner(HeadlessRunner::createRolloutConfig(config, options), entries,
+                                options.threads);
+        vector<StrategyReport> reports = runner.run(static_cast<uint32_t>(options.games));
+        
+        ostringstream table;
+        TournamentReport::printTable(table, reports, runner);
+        cout << table.str();
+        
+        bool written = true;
+        if (!options.csvPath.empty()) {
+            written &= writeFile(options.csvPath, [&](ostream& out) {
+                TournamentReport::writeSummaryCsv(out, reports);
+            });
+        }
+        if (!options.gamesCsvPath.empty()) {
+            written &= writeFile(options.gamesCsvPath, [&](ostream& out) {
+                TournamentReport::writeGamesCsv(out, reports);
+            });
+        }
+        return written ? 0 : 1;
+    }
+};
+
 // ============================================
 // Main Entry Point
 // ============================================
 
-int main() {
-    SnakeGameApp app;
+/**
+ * @brief Largest board side accepted on the command line.
+ */
+const int maxBoardSide = 4096;
+
+/**
+ * @brief Parses a whole argument as an integer within [minValue, maxValue].
+ * @throws invalid_argument if it is not a number, out_of_range if outside the range
+ */
+long long parseInteger(const string& text, long long minValue, long long maxValue) {
+    size_t used = 0;
+    long long value = 0;
+    try {
+        value = stoll(text, &used);
+    } catch (const logic_error&) {
+        throw invalid_argument(text);
+    }
+    if (used != text.size()) throw invalid_argument(text);
+    if (value < minValue || value > maxValue) throw out_of_range(text);
+    return value;
+}
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [--headless [--games N] [--max-ticks N]"
+         << " [--policy random|greedy|bfs|hamilton|mcts] [--seed N] [--threads N]]"
+         << " [--tournament all|NAME,NAME,... [--csv FILE] [--games-csv FILE]]"
+         << " [--autopilot random|greedy|bfs|hamilton|mcts] [--rows N] [--cols N]\n"
+         << "  --games >= 1, --max-ticks >= 0 (0 = 10 per cell), --threads >= 0 (0 = every core),"
+         << " --rows and --cols 2.." << maxBoardSide << "\n";
+}
+
+int main(int argc, char** argv) {
+    GameConfig config;
+    HeadlessOptions headlessOptions;
+    bool headless = false;
+    
+    string arg;
+    try {
+        for (int i = 1; i < argc; i++) {
+            arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--headless") {
+                headless = true;
+            } else if (arg == "--games" && hasValue) {
+                headlessOptions.games = parseInteger(argv[++i], 1, UINT32_MAX);
+            } else if (arg == "--max-ticks" && hasValue) {
+                headlessOptions.maxTicksPerGame = parseInteger(argv[++i], 0, LLONG_MAX);
+            } else if (arg == "--policy" && hasValue) {
+                headlessOptions.policy = argv[++i];
+            } else if (arg == "--seed" && hasValue) {
+                headlessOptions.seed = static_cast<unsigned int>(parseInteger(argv[++i], 0, UINT_MAX));
+            } else if (arg == "--threads" && hasValue) {
+                headlessOptions.threads = static_cast<int>(parseInteger(argv[++i], 0, 1024));
+            } else if (arg == "--tournament" && hasValue) {
+                headlessOptions.tournament = argv[++i];
+            } else if (arg == "--csv" && hasValue) {
+                headlessOptions.csvPath = argv[++i];
+            } else if (arg == "--games-csv" && hasValue) {
+                headlessOptions.gamesCsvPath = argv[++i];
+            } else if (arg == "--autopilot" && hasValue) {
+                config.autopilot = argv[++i];
+            } else if (arg == "--rows" && hasValue) {
+                config.rows = static_cast<int>(parseInteger(argv[++i], 2, maxBoardSide));
+            } else if (arg == "--cols" && hasValue) {
+                config.cols = static_cast<int>(parseInteger(argv[++i], 2, maxBoardSide));
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const logic_error& error) {
+        cerr << "Invalid value for " << arg << ": " << error.what() << "\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    if (!config.autopilot.empty() && !isAutopilotName(config.autopilot)) {
+        cerr << "Unknown autopilot: " << config.autopilot << " (expected random, greedy, bfs, hamilton or mcts)\n";
+        return 1;
+    }
+    
+    if (!headlessOptions.tournament.empty()) {
+        TournamentMode tournament(config, headlessOptions);
+        return tournament.run();
+    }
+    
+    if (headless) {
+        HeadlessRunner runner(config, headlessOptions);
+        return runner.run();
+    }
+    
+    SnakeGameApp app(config);
     app.run();
     return 0;
 }
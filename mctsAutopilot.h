@@ -0,0 +1,334 @@
+// mctsAutopilot.h
+#ifndef MCTSAUTOPILOT_H
+#define MCTSAUTOPILOT_H
+
+#include "autopilot.h"
+#include "workStealingPool.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+// ============================================================================
+// MONTE CARLO TREE SEARCH AUTOPILOT
+// ============================================================================
+
+/**
+ * @brief Search limits and tuning for MctsAutopilot.
+ *
+ * A decision stops at whichever limit is hit first. With no time budget
+ * and a single thread the search is deterministic for a given seed.
+ */
+struct MctsConfig {
+    int threads = 0;                ///< Search threads including the caller; 0 uses every core
+    int timeBudgetMs = 0;           ///< Hard wall-clock limit per decision; 0 for none
+    int maxIterations = 0;          ///< Rollouts per decision; 0 for none (needs a time budget)
+    int rolloutDepth = 20;          ///< Ticks simulated beyond the tree per rollout
+    int nodeCapacity = 1 << 18;     ///< Preallocated tree nodes
+    int virtualLoss = 3;            ///< Visits added to a path while a rollout is in flight
+    double exploration = 0.3;       ///< UCT exploration constant
+    double foodDiscount = 0.9;      ///< Per-tick discount on food rewards; favors eating sooner
+    uint64_t seed = 1;
+
+    /**
+     * @brief Settings for interactive play at a given tick length.
+     *
+     * Spends two thirds of the tick searching and leaves the rest for the
+     * update, the redraw and scheduling jitter.
+     * @param updateDelayMs GameConfig::updateDelay
+     * @return Time-limited config using every core
+     */
+    static MctsConfig forUpdateDelay(int updateDelayMs) {
+        MctsConfig config;
+        config.timeBudgetMs = max(1, updateDelayMs * 2 / 3);
+        return config;
+    }
+};
+
+/**
+ * @brief Tree-parallel open-loop MCTS over the four moves.
+ *
+ * Every worker of a WorkStealingPool descends one shared tree with UCT,
+ * simulating on its own copy of the game that it rewinds with a
+ * GameCheckpoint after each rollout, so a rollout costs a restore rather
+ * than a clone. Nodes are move sequences, not states: each rollout
+ * reseeds its copy so food spawns are sampled rather than read from the
+ * real game's generator. Paths in flight carry a virtual loss so that
+ * concurrent workers spread over different branches. Tree statistics are
+ * atomics in a preallocated node pool and children are expanded with a
+ * CAS, so the search takes no locks and does not allocate after the first
+ * decision.
+ */
+class MctsAutopilot : public Autopilot {
+private:
+    static constexpr int32_t Leaf = -1;
+    static constexpr int32_t Expanding = -2;
+    static constexpr int32_t Full = -3;             ///< Node pool exhausted; stays a leaf
+
+    struct Node {
+        atomic<int32_t> visits;                     ///< Real plus virtual visits
+        atomic<int32_t> firstChild;                 ///< Four children, UP..RIGHT, or Leaf/Expanding/Full
+        atomic<double> valueSum;
+
+        void clear() {
+            visits.store(0, memory_order_relaxed);
+            firstChild.store(Leaf, memory_order_relaxed);
+            valueSum.store(0.0, memory_order_relaxed);
+        }
+    };
+
+    struct alignas(64) WorkerContext {
+        unique_ptr<SnakeGameLogic> game;
+        GameCheckpoint root;
+        vector<int32_t> path;
+        uint64_t rollouts = 0;
+    };
+
+    MctsConfig config;
+    WorkStealingPool pool;
+    vector<WorkerContext> workers;
+    vector<Node> nodes;
+    atomic<int32_t> nodeCount;
+    atomic<int32_t> iterationsStarted;
+    int lastIterations;
+    int lastNodeCount;
+
+    /**
+     * @brief Allocates four children for a leaf; only the CAS winner expands.
+     */
+    void expand(Node& node) {
+        int32_t expected = Leaf;
+        if (!node.firstChild.compare_exchange_strong(expected, Expanding, memory_order_acq_rel)) {
+            return;
+        }
+        int32_t first = nodeCount.fetch_add(4, memory_order_relaxed);
+        if (first + 4 > static_cast<int32_t>(nodes.size())) {
+            node.firstChild.store(Full, memory_order_release);
+            return;
+        }
+        for (int i = 0; i < 4; i++) nodes[first + i].clear();
+        node.firstChild.store(first, memory_order_release);
+    }
+
+    /**
+     * @brief Picks the child with the best UCT score among the moves that
+     *        survive the next tick (the reversal never counts as a move).
+     *
+     * Moves into walls or the body would only drag their parent's mean
+     * towards zero, so they are searched only when nothing else survives.
+     */
+    int selectChild(const Node& node, int32_t first, const SnakeGameLogic& game) const {
+        Direction reverse = MoveHelper::opposite(game.getCurrentDirection());
+        bool candidate[4];
+        bool anySafe = false;
+        for (int d = 0; d < 4; d++) {
+            candidate[d] = MoveHelper::isSafe(game, static_cast<Direction>(d));
+            anySafe = anySafe || candidate[d];
+        }
+        if (!anySafe) {
+            for (int d = 0; d < 4; d++) candidate[d] = static_cast<Direction>(d) != reverse;
+        }
+
+        double logVisits = log(max(1, node.visits.load(memory_order_relaxed)));
+        int best = -1;
+        double bestScore = -1.0;
+        for (int d = 0; d < 4; d++) {
+            if (!candidate[d]) continue;
+            const Node& child = nodes[first + d];
+            int32_t visits = child.visits.load(memory_order_relaxed);
+            if (visits == 0) return d;
+            double mean = child.valueSum.load(memory_order_relaxed) / visits;
+            double score = mean + config.exploration * sqrt(logVisits / visits);
+            if (score > bestScore) {
+                bestScore = score;
+                best = d;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Default policy: towards the food among safe moves, sometimes random.
+     */
+    static Direction rolloutMove(const SnakeGameLogic& game, Xoshiro256& rng) {
+        Direction safe[4];
+        int safeCount = 0;
+        for (int d = 0; d < 4; d++) {
+            if (MoveHelper::isSafe(game, static_cast<Direction>(d))) {
+                safe[safeCount++] = static_cast<Direction>(d);
+            }
+        }
+        if (safeCount == 0) return game.getCurrentDirection();
+        if (rng.nextBounded(4) == 0) return safe[rng.nextBounded(safeCount)];
+
+        pair<int, int> head = game.getSnake().getHead();
+        pair<int, int> food = game.getFoodManager().getPosition();
+        Direction best = safe[0];
+        int bestDistance = -1;
+        for (int i = 0; i < safeCount; i++) {
+            int distance = abs(food.first - head.first - MoveHelper::rowDelta[safe[i]]) +
+                           abs(food.second - head.second - MoveHelper::colDelta[safe[i]]);
+            if (bestDistance < 0 || distance < bestDistance) {
+                bestDistance = distance;
+                best = safe[i];
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Scores a finished rollout in [0, 1]: survival first, then food
+     *        eaten (discounted, so sooner is better), then closeness to the
+     *        next food.
+     * @param discountedFood Sum of foodDiscount^tick over the ticks that ate
+     */
+    static double evaluate(const SnakeGameLogic& game, double discountedFood) {
+        double foodTerm = discountedFood / (discountedFood + 1.0);
+        if (game.hasEnded()) {
+            return game.getGameOverReason() == BOARD_FULL ? 1.0 : 0.25 * foodTerm;
+        }
+        const Board& board = game.getBoard();
+        pair<int, int> head = game.getSnake().getHead();
+        pair<int, int> food = game.getFoodManager().getPosition();
+        int distance = abs(food.first - head.first) + abs(food.second - head.second);
+        double closeness = 1.0 - static_cast<double>(distance) / (board.getRows() + board.getCols());
+        return 0.3 + 0.6 * foodTerm + 0.1 * closeness;
+    }
+
+    /**
+     * @brief One worker's search loop: select, expand, roll out, back up.
+     */
+    void search(int worker, chrono::steady_clock::time_point deadline) {
+        WorkerContext& context = workers[worker];
+        SnakeGameLogic& game = *context.game;
+        Xoshiro256 rolloutRng(config.seed ^ 0x6A09E667F3BCC909ULL, worker);
+        int32_t virtualLoss = config.virtualLoss;
+
+        while (true) {
+            if (config.timeBudgetMs > 0 && chrono::steady_clock::now() >= deadline) break;
+            int32_t iteration = iterationsStarted.fetch_add(1, memory_order_relaxed);
+            if (config.maxIterations > 0 && iteration >= config.maxIterations) break;
+
+            game.restoreFrom(context.root);
+            game.setSeed(config.seed, ++context.rollouts * workers.size() + worker);
+
+            // Selection and expansion, one new level per rollout
+            int lastScore = game.getCurrentScore();
+            double discount = 1.0;
+            double discountedFood = 0.0;
+            auto advance = [&](Direction direction) {
+                game.setDirection(direction);
+                game.update();
+                discount *= config.foodDiscount;
+                if (game.getCurrentScore() != lastScore) {
+                    lastScore = game.getCurrentScore();
+                    discountedFood += discount;
+                }
+            };
+
+            context.path.clear();
+            context.path.push_back(0);
+            nodes[0].visits.fetch_add(virtualLoss, memory_order_relaxed);
+            int32_t node = 0;
+            bool expanded = false;
+            while (!game.hasEnded()) {
+                int32_t first = nodes[node].firstChild.load(memory_order_acquire);
+                if (first == Leaf && !expanded) {
+                    expand(nodes[node]);
+                    expanded = true;
+                    first = nodes[node].firstChild.load(memory_order_acquire);
+                }
+                if (first < 0) break;
+
+                int d = selectChild(nodes[node], first, game);
+                node = first + d;
+                nodes[node].visits.fetch_add(virtualLoss, memory_order_relaxed);
+                context.path.push_back(node);
+                advance(static_cast<Direction>(d));
+                if (expanded) break;
+            }
+
+            // Rollout with the default policy
+            for (int tick = 0; tick < config.rolloutDepth && !game.hasEnded(); tick++) {
+                advance(rolloutMove(game, rolloutRng));
+            }
+
+            // Backup, replacing the virtual loss with the real visit
+            double value = evaluate(game, discountedFood);
+            for (int32_t visited : context.path) {
+                nodes[visited].visits.fetch_add(1 - virtualLoss, memory_order_relaxed);
+                nodes[visited].valueSum.fetch_add(value, memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Creates the search pool, one simulation game per worker and the node pool.
+     * @param config Limits and tuning; see MctsConfig::forUpdateDelay()
+     */
+    explicit MctsAutopilot(const MctsConfig& config)
+        : config(config), pool(config.threads), workers(pool.getWorkerCount()),
+          nodes(max(config.nodeCapacity, 5)), nodeCount(1), iterationsStarted(0),
+          lastIterations(0), lastNodeCount(0) {
+        if (this->config.timeBudgetMs <= 0 && this->config.maxIterations <= 0) {
+            this->config.maxIterations = 1000;
+        }
+        for (WorkerContext& worker : workers) {
+            worker.game = make_unique<SnakeGameLogic>(config.seed);
+            worker.path.reserve(256);
+        }
+    }
+
+    Direction decide(const SnakeGameLogic& game) override {
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(config.timeBudgetMs);
+        if (game.hasEnded()) return game.getCurrentDirection();
+
+        nodes[0].clear();
+        nodeCount.store(1, memory_order_relaxed);
+        iterationsStarted.store(0, memory_order_relaxed);
+        for (WorkerContext& worker : workers) {
+            game.copyStateTo(*worker.game);
+            worker.game->saveTo(worker.root);
+        }
+
+        pool.parallelFor(static_cast<uint32_t>(workers.size()), [&](int worker, uint32_t) {
+            search(worker, deadline);
+        });
+
+        int started = iterationsStarted.load(memory_order_relaxed);
+        lastIterations = config.maxIterations > 0 ? min(started, config.maxIterations) : started;
+        lastNodeCount = min(nodeCount.load(memory_order_relaxed), static_cast<int32_t>(nodes.size()));
+
+        // Most visited root move; fall back to greedy if the budget allowed no expansion
+        int32_t first = nodes[0].firstChild.load(memory_order_acquire);
+        if (first < 0) return GreedyAutopilot().decide(game);
+        Direction reverse = MoveHelper::opposite(game.getCurrentDirection());
+        Direction best = game.getCurrentDirection();
+        int32_t bestVisits = -1;
+        for (int d = 0; d < 4; d++) {
+            if (static_cast<Direction>(d) == reverse) continue;
+            int32_t visits = nodes[first + d].visits.load(memory_order_relaxed);
+            if (visits > bestVisits) {
+                bestVisits = visits;
+                best = static_cast<Direction>(d);
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Sets the search seed and restarts the rollout stream numbering.
+     */
+    void reseed(uint64_t seed) override {
+        config.seed = seed;
+        for (WorkerContext& worker : workers) worker.rollouts = 0;
+    }
+
+    string getName() const override { return "mcts"; }
+
+    int getLastIterations() const { return lastIterations; }
+    int getLastNodeCount() const { return lastNodeCount; }
+    int getThreadCount() const { return pool.getWorkerCount(); }
+};
+
+#endif // MCTSAUTOPILOT_H
@@ -0,0 +1,240 @@
+// observationEncoder.h
+#ifndef OBSERVATIONENCODER_H
+#define OBSERVATIONENCODER_H
+
+#include "gameLogic.h"
+#include "batchEngine.h"
+#include "batchKernels.h"
+#include <algorithm>
+
+// ============================================================================
+// OBSERVATION ENCODER
+// ============================================================================
+
+/**
+ * @brief Channel order of encoded observations.
+ */
+enum ObservationPlane {
+    PLANE_BODY = 0,     ///< Snake cells other than the head
+    PLANE_HEAD = 1,
+    PLANE_FOOD = 2,
+    PLANE_WALL = 3,     ///< Wall cells, plus off-board cells in egocentric crops
+    PLANE_COUNT = 4
+};
+
+/**
+ * @brief Turns row-major cell bytes into one-hot planes for training.
+ *
+ * Output is channel-major: PLANE_COUNT planes of height * width values,
+ * each 0 or 1, as uint8_t or float. Each board row is encoded as one span
+ * with byte compares against SNAKE, FOOD and WALL (32 cells per step with
+ * AVX2) instead of branching per cell; only the head is patched
+ * afterwards. encodeEgocentric() instead centers a (2r + 1)^2 window on
+ * the head and marks cells beyond the board as walls.
+ */
+class ObservationEncoder {
+private:
+    KernelLevel level;
+
+    template <typename T>
+    static void encodeSpanScalar(const uint8_t* cells, int count, T* body, T* food, T* wall) {
+        for (int i = 0; i < count; i++) {
+            body[i] = static_cast<T>(cells[i] == SNAKE);
+            food[i] = static_cast<T>(cells[i] == FOOD);
+            wall[i] = static_cast<T>(cells[i] == WALL);
+        }
+    }
+
+#ifdef SNAKE_X86_KERNELS
+    __attribute__((target("avx2")))
+    static void encodeSpanAvx2(const uint8_t* cells, int count, uint8_t* body, uint8_t* food,
+                               uint8_t* wall) {
+        const __m256i one = _mm256_set1_epi8(1);
+        const __m256i snake = _mm256_set1_epi8(SNAKE);
+        const __m256i foodType = _mm256_set1_epi8(FOOD);
+        const __m256i wallType = _mm256_set1_epi8(WALL);
+        int i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(body + i),
+                                _mm256_and_si256(_mm256_cmpeq_epi8(v, snake), one));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(food + i),
+                                _mm256_and_si256(_mm256_cmpeq_epi8(v, foodType), one));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(wall + i),
+                                _mm256_and_si256(_mm256_cmpeq_epi8(v, wallType), one));
+        }
+        encodeSpanScalar(cells + i, count - i, body + i, food + i, wall + i);
+    }
+
+    /**
+     * @brief Float version: widens 8 cells to 32-bit lanes and masks the
+     *        bit pattern of 1.0f with each compare result.
+     */
+    __attribute__((target("avx2")))
+    static void encodeSpanAvx2(const uint8_t* cells, int count, float* body, float* food,
+                               float* wall) {
+        const __m256i oneBits = _mm256_castps_si256(_mm256_set1_ps(1.0f));
+        const __m256i snake = _mm256_set1_epi32(SNAKE);
+        const __m256i foodType = _mm256_set1_epi32(FOOD);
+        const __m256i wallType = _mm256_set1_epi32(WALL);
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(cells + i)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(body + i),
+                                _mm256_and_si256(_mm256_cmpeq_epi32(v, snake), oneBits));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(food + i),
+                                _mm256_and_si256(_mm256_cmpeq_epi32(v, foodType), oneBits));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(wall + i),
+                                _mm256_and_si256(_mm256_cmpeq_epi32(v, wallType), oneBits));
+        }
+        encodeSpanScalar(cells + i, count - i, body + i, food + i, wall + i);
+    }
+#endif
+
+    template <typename T>
+    void encodeSpan(const uint8_t* cells, int count, T* body, T* food, T* wall) const {
+#ifdef SNAKE_X86_KERNELS
+        if (level == KernelLevel::AVX2) {
+            encodeSpanAvx2(cells, count, body, food, wall);
+            return;
+        }
+#endif
+        encodeSpanScalar(cells, count, body, food, wall);
+    }
+
+public:
+    /**
+     * @brief Creates an encoder using the best kernel the CPU supports.
+     */
+    ObservationEncoder() : level(BatchKernels::detectLevel()) {}
+
+    /**
+     * @brief Chooses the span kernel, e.g. to compare against scalar.
+     * @param requested Level; clamped to what the CPU supports
+     */
+    void setKernelLevel(KernelLevel requested) {
+        KernelLevel supported = BatchKernels::detectLevel();
+        level = static_cast<int>(requested) > static_cast<int>(supported) ? supported : requested;
+    }
+
+    KernelLevel getKernelLevel() const { return level; }
+
+    /**
+     * @brief Encodes a whole board.
+     * @param cells Row-major cells (rows * cols)
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param headIndex Flat index of the snake head, or -1 for none
+     * @param out PLANE_COUNT * rows * cols values
+     */
+    template <typename T>
+    void encode(const uint8_t* cells, int rows, int cols, int headIndex, T* out) const {
+        size_t planeSize = static_cast<size_t>(rows) * cols;
+        T* body = out + PLANE_BODY * planeSize;
+        T* head = out + PLANE_HEAD * planeSize;
+        encodeSpan(cells, static_cast<int>(planeSize), body,
+                   out + PLANE_FOOD * planeSize, out + PLANE_WALL * planeSize);
+        fill(head, head + planeSize, T(0));
+        if (headIndex >= 0) {
+            body[headIndex] = T(0);
+            head[headIndex] = T(1);
+        }
+    }
+
+    /**
+     * @brief Encodes a head-centered (2 * radius + 1)^2 window.
+     * @param cells Row-major cells (rows * cols)
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param headRow Head row; the window's center
+     * @param headCol Head column
+     * @param radius Cells visible on each side of the head
+     * @param out PLANE_COUNT * (2 * radius + 1)^2 values
+     */
+    template <typename T>
+    void encodeEgocentric(const uint8_t* cells, int rows, int cols, int headRow, int headCol,
+                          int radius, T* out) const {
+        int side = 2 * radius + 1;
+        size_t planeSize = static_cast<size_t>(side) * side;
+        fill(out, out + PLANE_WALL * planeSize, T(0));
+        fill(out + PLANE_WALL * planeSize, out + PLANE_COUNT * planeSize, T(1));
+
+        // Board columns covered by the window, as offsets into a window row
+        int firstCol = max(0, headCol - radius);
+        int lastCol = min(cols - 1, headCol + radius);
+        for (int y = 0; y < side; y++) {
+            int r = headRow - radius + y;
+            if (r < 0 || r >= rows || firstCol > lastCol) continue;
+            size_t offset = static_cast<size_t>(y) * side + (firstCol - (headCol - radius));
+            encodeSpan(cells + static_cast<size_t>(r) * cols + firstCol, lastCol - firstCol + 1,
+                       out + PLANE_BODY * planeSize + offset,
+                       out + PLANE_FOOD * planeSize + offset,
+                       out + PLANE_WALL * planeSize + offset);
+        }
+
+        size_t center = static_cast<size_t>(radius) * side + radius;
+        out[PLANE_BODY * planeSize + center] = T(0);
+        out[PLANE_HEAD * planeSize + center] = T(1);
+    }
+
+    /**
+     * @brief Encodes a SnakeGameLogic's board on the game thread.
+     * @param game Game between two update() calls
+     * @param radius Egocentric radius, or -1 for the whole board
+     * @param out Output planes (see encode() and encodeEgocentric())
+     */
+    template <typename T>
+    void encode(const SnakeGameLogic& game, int radius, T* out) const {
+        const Board& board = game.getBoard();
+        pair<int, int> head = game.getSnake().getHead();
+        if (radius < 0) {
+            encode(board.getCells().data(), board.getRows(), board.getCols(),
+                   board.indexOf(head.first, head.second), out);
+        } else {
+            encodeEgocentric(board.getCells().data(), board.getRows(), board.getCols(),
+                             head.first, head.second, radius, out);
+        }
+    }
+
+    /**
+     * @brief Encodes games of a batch, one observation after another.
+     * @param batch Batch engine
+     * @param radius Egocentric radius, or -1 for whole boards
+     * @param out getGameCount() * observationSize(...) values; game i is
+     *        always written at offset i * observationSize(...)
+     * @param begin First game to encode
+     * @param end One past the last game, or -1 for all remaining games
+     */
+    template <typename T>
+    void encodeBatch(const BatchSnakeEngine& batch, int radius, T* out,
+                     int begin = 0, int end = -1) const {
+        int rows = batch.getRows();
+        int cols = batch.getCols();
+        size_t stride = observationSize(rows, cols, radius);
+        if (end < 0) end = batch.getGameCount();
+        for (int game = begin; game < end; game++) {
+            pair<int, int> head = batch.getHead(game);
+            if (radius < 0) {
+                encode(batch.getCells(game), rows, cols, head.first * cols + head.second,
+                       out + game * stride);
+            } else {
+                encodeEgocentric(batch.getCells(game), rows, cols, head.first, head.second,
+                                 radius, out + game * stride);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the number of values in one encoded observation.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param radius Egocentric radius, or -1 for whole boards
+     * @return PLANE_COUNT times the plane size
+     */
+    static size_t observationSize(int rows, int cols, int radius) {
+        if (radius < 0) return static_cast<size_t>(PLANE_COUNT) * rows * cols;
+        return static_cast<size_t>(PLANE_COUNT) * (2 * radius + 1) * (2 * radius + 1);
+    }
+};
+
+#endif // OBSERVATIONENCODER_H
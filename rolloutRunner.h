@@ -0,0 +1,172 @@
+// rolloutRunner.h
+#ifndef ROLLOUTRUNNER_H
+#define ROLLOUTRUNNER_H
+
+#include "gameLogic.h"
+#include "autopilot.h"
+#include "workStealingPool.h"
+#include <functional>
+#include <limits>
+
+// ============================================================================
+// ROLLOUT STATISTICS
+// ============================================================================
+
+/**
+ * @brief Outcome of one episode.
+ */
+struct EpisodeResult {
+    int score;
+    int length;
+    long long ticks;
+    GameOverReason reason;          ///< NOT_OVER when the episode hit the tick cap
+};
+
+/**
+ * @brief Aggregated episode outcomes; one per worker, merged at the end.
+ */
+struct RolloutStats {
+    long long episodes = 0;
+    long long totalTicks = 0;
+    long long totalScore = 0;
+    long long minTicks = numeric_limits<long long>::max();
+    long long maxTicks = 0;
+    int maxScore = 0;
+    int maxLength = 0;
+    array<long long, 5> endings{};  ///< Episodes per GameOverReason; NOT_OVER = capped
+    vector<int> scores;             ///< Every episode's score, in completion order
+
+    void add(const EpisodeResult& result) {
+        episodes++;
+        totalTicks += result.ticks;
+        totalScore += result.score;
+        minTicks = min(minTicks, result.ticks);
+        maxTicks = max(maxTicks, result.ticks);
+        maxScore = max(maxScore, result.score);
+        maxLength = max(maxLength, result.length);
+        endings[result.reason]++;
+        scores.push_back(result.score);
+    }
+
+    void merge(const RolloutStats& other) {
+        episodes += other.episodes;
+        totalTicks += other.totalTicks;
+        totalScore += other.totalScore;
+        minTicks = min(minTicks, other.minTicks);
+        maxTicks = max(maxTicks, other.maxTicks);
+        maxScore = max(maxScore, other.maxScore);
+        maxLength = max(maxLength, other.maxLength);
+        for (size_t i = 0; i < endings.size(); i++) endings[i] += other.endings[i];
+        scores.insert(scores.end(), other.scores.begin(), other.scores.end());
+    }
+};
+
+// ============================================================================
+// ROLLOUT RUNNER
+// ============================================================================
+
+/**
+ * @brief Settings shared by every episode of a rollout.
+ */
+struct RolloutConfig {
+    int rows = 20;
+    int cols = 40;
+    int startingLength = 3;
+    int pointsPerFood = 10;
+    Direction initialDirection = RIGHT;
+    long long maxTicksPerEpisode = 0;   ///< 0 caps at 10 * rows * cols
+    uint64_t seed = 1;
+};
+
+/**
+ * @brief Plays many independent episodes on a WorkStealingPool.
+ *
+ * Each worker owns a SnakeGameLogic, an Autopilot and a RolloutStats, all
+ * reused across episodes; the per-worker stats are merged after the pool
+ * finishes, so no lock or shared counter is touched per episode. Episode i
+ * places food from stream i of the seed, so with a deterministic policy
+ * the outcome of every episode is independent of the thread count and the
+ * steal schedule.
+ */
+class RolloutRunner {
+public:
+    using PolicyFactory = function<unique_ptr<Autopilot>(uint64_t seed)>;
+
+private:
+    struct alignas(64) WorkerContext {
+        unique_ptr<SnakeGameLogic> game;
+        unique_ptr<Autopilot> policy;
+        RolloutStats stats;
+    };
+
+    RolloutConfig config;
+    PolicyFactory policyFactory;
+    WorkStealingPool pool;
+    vector<WorkerContext> workers;
+
+    EpisodeResult playEpisode(WorkerContext& worker, uint32_t episode) {
+        long long maxTicks = config.maxTicksPerEpisode > 0
+            ? config.maxTicksPerEpisode
+            : 10LL * config.rows * config.cols;
+
+        SnakeGameLogic& game = *worker.game;
+        game.setSeed(config.seed, episode);
+        game.initializeBoard(config.rows, config.cols, config.startingLength,
+                             config.pointsPerFood, config.initialDirection);
+        worker.policy->reset();
+
+        long long ticks = 0;
+        bool alive = true;
+        while (alive && ticks < maxTicks) {
+            game.setDirection(worker.policy->decide(game));
+            alive = game.update();
+            ticks++;
+        }
+        return {game.getCurrentScore(), static_cast<int>(game.getSnake().getLength()), ticks,
+                game.getGameOverReason()};
+    }
+
+public:
+    /**
+     * @brief Creates the pool and one game and policy per worker.
+     * @param config Episode settings
+     * @param policyFactory Creates a worker's policy from its own seed
+     * @param threads Worker count including the caller; 0 uses every core
+     */
+    RolloutRunner(const RolloutConfig& config, PolicyFactory policyFactory, int threads = 0)
+        : config(config), policyFactory(move(policyFactory)), pool(threads),
+          workers(pool.getWorkerCount()) {
+        for (int i = 0; i < pool.getWorkerCount(); i++) {
+            workers[i].game = make_unique<SnakeGameLogic>(config.seed);
+            // Nothing reads snapshots, so ticks/s measures the rules and policy alone
+            workers[i].game->setPublishing(false);
+            // Worker i's policy seed comes from stream i of a separate base seed
+            workers[i].policy = this->policyFactory(Xoshiro256(~config.seed, i)());
+        }
+    }
+
+    /**
+     * @brief Plays a batch of episodes and reduces their stats.
+     * @param episodes Number of episodes, numbered 0 to episodes - 1
+     * @return Stats over the whole batch
+     */
+    RolloutStats run(uint32_t episodes) {
+        for (WorkerContext& worker : workers) {
+            worker.stats = RolloutStats();
+        }
+        pool.parallelFor(episodes, [&](int worker, uint32_t episode) {
+            workers[worker].stats.add(playEpisode(workers[worker], episode));
+        });
+
+        RolloutStats total;
+        for (const WorkerContext& worker : workers) {
+            total.merge(worker.stats);
+        }
+        return total;
+    }
+
+    int getThreadCount() const { return pool.getWorkerCount(); }
+    uint64_t getStealCount() const { return pool.getStealCount(); }
+};
+
+#endif // ROLLOUTRUNNER_H
@@ -0,0 +1,221 @@
+// snakeEnv.cpp
+// libsnake: C ABI over BatchSnakeEngine. Build with
+//   g++ -std=c++20 -O2 -shared -fPIC -fvisibility=hidden snakeEnv.cpp -o libsnake.so
+
+#include "snakeEnv.h"
+#include "batchEngine.h"
+#include "observationEncoder.h"
+#include "batchPipeline.h"
+#include <new>
+
+// ============================================================================
+// ENVIRONMENT
+// ============================================================================
+
+/**
+ * @brief Batch engine plus an action buffer.
+ *
+ * All buffers are sized once in env_create(), so stepping never allocates.
+ */
+struct SnakeEnv {
+    BatchSnakeEngine engine;
+    ObservationEncoder encoder;
+    vector<Direction> actions;
+    uint64_t seed;
+
+    SnakeEnv(int numEnvs, int rows, int cols)
+        : engine(numEnvs, rows, cols, 3, 1, RIGHT), actions(numEnvs, NONE), seed(0) {}
+
+    /**
+     * @brief Copies one game's board into an observation, marking the head.
+     */
+    void writeObservation(int game, uint8_t* out) const {
+        int cellCount = engine.getRows() * engine.getCols();
+        memcpy(out, engine.getCells(game), cellCount);
+        pair<int, int> head = engine.getHead(game);
+        out[head.first * engine.getCols() + head.second] = SNAKE_OBS_HEAD;
+    }
+
+    /**
+     * @brief Reward of a game's last step: +1 per food, -1 on death.
+     */
+    static float reward(const BatchSnakeEngine& engine, int game) {
+        bool died = engine.didEpisodeEnd(game) &&
+                    engine.getEpisodeLength(game) < engine.getRows() * engine.getCols();
+        return (engine.wasFoodEaten(game) ? 1.0f : 0.0f) - (died ? 1.0f : 0.0f);
+    }
+
+    void writeObservations(uint8_t* out) const {
+        size_t cellCount = static_cast<size_t>(engine.getRows()) * engine.getCols();
+        for (int game = 0; game < engine.getGameCount(); game++) {
+            writeObservation(game, out + game * cellCount);
+        }
+    }
+};
+
+/**
+ * @brief BatchPipeline behind the opaque C handle.
+ */
+struct SnakePipeline {
+    BatchPipeline pipeline;
+
+    SnakePipeline(int gamesPerBatch, int rows, int cols, int cropRadius, int threads, uint64_t seed)
+        : pipeline(gamesPerBatch, rows, cols, cropRadius, threads, seed) {}
+};
+
+/// Largest crop radius accepted: its four planes still fit an int32 count
+static const int32_t maxCropRadius = 11584;
+
+/**
+ * @brief Gets the values per game for a crop radius, checked for the ABI.
+ *
+ * Rejects radii whose 2 * radius + 1 side would overflow in the encoder,
+ * and whole boards whose planes do not fit the int32 result.
+ * @return Values per game, or -1 if the radius or board is too large
+ */
+static int32_t checkedPlanesSize(int rows, int cols, int32_t cropRadius) {
+    if (cropRadius > maxCropRadius) {
+        return -1;
+    }
+    size_t size = ObservationEncoder::observationSize(rows, cols, cropRadius < 0 ? -1 : cropRadius);
+    return size > static_cast<size_t>(INT32_MAX) ? -1 : static_cast<int32_t>(size);
+}
+
+// ============================================================================
+// C ABI
+// ============================================================================
+
+extern "C" {
+
+SNAKE_API SnakeEnv* env_create(int32_t num_envs, int32_t rows, int32_t cols) {
+    if (num_envs <= 0 || rows <= 0 || cols <= 0 ||
+        static_cast<int64_t>(rows) * cols > INT32_MAX / 2) {
+        return nullptr;
+    }
+    // Exceptions must not cross the C boundary
+    try {
+        return new SnakeEnv(num_envs, rows, cols);
+    } catch (const exception&) {
+        return nullptr;
+    }
+}
+
+SNAKE_API void env_destroy(SnakeEnv* env) {
+    delete env;
+}
+
+SNAKE_API void env_reset(SnakeEnv* env, uint64_t seed, uint8_t* obs_out) {
+    env->seed = seed;
+    env->engine.resetAll(seed);
+    if (env->engine.isAutoReset()) {
+        env->engine.setAutoReset(true, seed);
+    }
+    if (obs_out) {
+        env->writeObservations(obs_out);
+    }
+}
+
+SNAKE_API void env_step(SnakeEnv* env, const int32_t* actions, uint8_t* obs_out,
+                        float* reward_out, uint8_t* done_out) {
+    BatchSnakeEngine& engine = env->engine;
+    int gameCount = engine.getGameCount();
+    for (int game = 0; game < gameCount; game++) {
+        int32_t action = actions[game];
+        env->actions[game] = action >= SNAKE_ACTION_UP && action <= SNAKE_ACTION_NONE
+            ? static_cast<Direction>(action)
+            : NONE;
+    }
+
+    engine.step(env->actions.data());
+
+    for (int game = 0; game < gameCount; game++) {
+        if (reward_out) {
+            reward_out[game] = SnakeEnv::reward(engine, game);
+        }
+        if (done_out) {
+            done_out[game] = engine.didEpisodeEnd(game) || engine.isDone(game);
+        }
+    }
+
+    if (obs_out) {
+        env->writeObservations(obs_out);
+    }
+}
+
+SNAKE_API void env_set_auto_reset(SnakeEnv* env, int32_t enabled) {
+    env->engine.setAutoReset(enabled != 0, env->seed);
+}
+
+SNAKE_API int32_t env_encode_u8(const SnakeEnv* env, int32_t crop_radius, uint8_t* out) {
+    if (env_planes_size(env, crop_radius) < 0) {
+        return -1;
+    }
+    env->encoder.encodeBatch(env->engine, crop_radius < 0 ? -1 : crop_radius, out);
+    return 0;
+}
+
+SNAKE_API int32_t env_encode_f32(const SnakeEnv* env, int32_t crop_radius, float* out) {
+    if (env_planes_size(env, crop_radius) < 0) {
+        return -1;
+    }
+    env->encoder.encodeBatch(env->engine, crop_radius < 0 ? -1 : crop_radius, out);
+    return 0;
+}
+
+SNAKE_API int32_t env_planes_size(const SnakeEnv* env, int32_t crop_radius) {
+    return checkedPlanesSize(env->engine.getRows(), env->engine.getCols(), crop_radius);
+}
+
+SNAKE_API SnakePipeline* pipeline_create(int32_t games_per_batch, int32_t rows, int32_t cols,
+                                         int32_t crop_radius, int32_t threads, uint64_t seed) {
+    if (games_per_batch <= 0 || rows <= 0 || cols <= 0 || threads < 0 ||
+        static_cast<int64_t>(rows) * cols > INT32_MAX / 2 ||
+        checkedPlanesSize(rows, cols, crop_radius) < 0) {
+        return nullptr;
+    }
+    try {
+        return new SnakePipeline(games_per_batch, rows, cols, crop_radius < 0 ? -1 : crop_radius,
+                                 threads, seed);
+    } catch (const exception&) {
+        return nullptr;
+    }
+}
+
+SNAKE_API void pipeline_destroy(SnakePipeline* pipeline) {
+    delete pipeline;
+}
+
+SNAKE_API void pipeline_acquire(SnakePipeline* pipeline, SnakeBatchView* view) {
+    PipelineBatch& batch = pipeline->pipeline.acquire();
+    view->batch_id = batch.id;
+    view->obs = batch.observations.data();
+    view->reward = batch.rewards.data();
+    view->done = batch.dones.data();
+    view->episode_score = batch.episodeScores.data();
+    view->actions = batch.actions.data();
+}
+
+SNAKE_API int32_t pipeline_submit(SnakePipeline* pipeline, int32_t batch_id) {
+    if (batch_id != 0 && batch_id != 1) {
+        return -1;
+    }
+    return pipeline->pipeline.submit(pipeline->pipeline.getBatch(batch_id)) ? 0 : -1;
+}
+
+SNAKE_API int32_t pipeline_obs_size(const SnakePipeline* pipeline) {
+    return static_cast<int32_t>(pipeline->pipeline.getObservationSize());
+}
+
+SNAKE_API int32_t env_num_envs(const SnakeEnv* env) {
+    return env->engine.getGameCount();
+}
+
+SNAKE_API int32_t env_obs_size(const SnakeEnv* env) {
+    return env->engine.getRows() * env->engine.getCols();
+}
+
+SNAKE_API int32_t env_score(const SnakeEnv* env, int32_t game) {
+    return env->engine.getScore(game);
+}
+
+}
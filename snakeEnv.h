@@ -0,0 +1,150 @@
+/* snakeEnv.h */
+#ifndef SNAKEENV_H
+#define SNAKEENV_H
+
+/*
+ * C ABI for embedding the engine as a vectorized reinforcement-learning
+ * environment (libsnake). One SnakeEnv steps num_envs independent games
+ * per call. Every output is written into caller-owned buffers; no call
+ * after env_create() allocates.
+ *
+ * Observations are num_envs * rows * cols bytes, game-major and row-major
+ * within a game, using the SNAKE_OBS_* cell codes. Actions are one int32
+ * per game using the SNAKE_ACTION_* codes; out-of-range values are
+ * treated as SNAKE_ACTION_NONE.
+ */
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+    #define SNAKE_API __declspec(dllexport)
+#else
+    #define SNAKE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    SNAKE_ACTION_UP = 0,
+    SNAKE_ACTION_DOWN = 1,
+    SNAKE_ACTION_LEFT = 2,
+    SNAKE_ACTION_RIGHT = 3,
+    SNAKE_ACTION_NONE = 4       /* keep the current direction */
+};
+
+enum {
+    SNAKE_OBS_EMPTY = 0,
+    SNAKE_OBS_BODY = 1,
+    SNAKE_OBS_FOOD = 2,
+    SNAKE_OBS_WALL = 3,
+    SNAKE_OBS_HEAD = 4
+};
+
+typedef struct SnakeEnv SnakeEnv;
+typedef struct SnakePipeline SnakePipeline;
+
+/* One half of a SnakePipeline's double buffer, owned by the pipeline. */
+typedef struct SnakeBatchView {
+    int32_t batch_id;
+    const float* obs;               /* games_per_batch * pipeline_obs_size() planes */
+    const float* reward;
+    const uint8_t* done;            /* 1 when the last step ended an episode */
+    const int32_t* episode_score;   /* final score where done is 1 */
+    int32_t* actions;               /* fill before pipeline_submit() */
+} SnakeBatchView;
+
+/**
+ * @brief Creates num_envs games of one board size (snake length 3).
+ * @return Environment, or NULL on invalid sizes or allocation failure
+ */
+SNAKE_API SnakeEnv* env_create(int32_t num_envs, int32_t rows, int32_t cols);
+
+SNAKE_API void env_destroy(SnakeEnv* env);
+
+/**
+ * @brief Starts every game; game i places food from stream i of the seed.
+ * @param obs_out Observation buffer, or NULL to skip writing it
+ */
+SNAKE_API void env_reset(SnakeEnv* env, uint64_t seed, uint8_t* obs_out);
+
+/**
+ * @brief Advances every unfinished game by one tick.
+ *
+ * Rewards are +1 per food eaten and -1 on death (0 when the snake fills
+ * the board). Finished games stay finished, with reward 0 and done 1,
+ * until the next env_reset(), unless auto-reset is on.
+ * @param actions num_envs actions
+ * @param obs_out num_envs * rows * cols bytes, or NULL
+ * @param reward_out num_envs rewards, or NULL
+ * @param done_out num_envs flags (1 when the game is over), or NULL
+ */
+SNAKE_API void env_step(SnakeEnv* env, const int32_t* actions, uint8_t* obs_out,
+                        float* reward_out, uint8_t* done_out);
+
+/**
+ * @brief Restarts games in place as soon as they end.
+ *
+ * The step that ends a game still reports its reward and done = 1, but
+ * its observation already shows the next episode. Episode k of game i
+ * uses stream k * num_envs + i of the env_reset() seed.
+ * @param enabled Non-zero to auto-reset
+ */
+SNAKE_API void env_set_auto_reset(SnakeEnv* env, int32_t enabled);
+
+/**
+ * @brief Writes one-hot planes (body, head, food, wall) for every game.
+ *
+ * Channel-major per game: 4 planes of rows * cols values, or of
+ * (2 * crop_radius + 1)^2 values centered on the head when crop_radius is
+ * non-negative (off-board cells count as wall).
+ * @param crop_radius Egocentric radius, or -1 for the whole board
+ * @param out num_envs * env_planes_size(env, crop_radius) values
+ * @return 0, or -1 (nothing written) when env_planes_size() rejects the radius
+ */
+SNAKE_API int32_t env_encode_u8(const SnakeEnv* env, int32_t crop_radius, uint8_t* out);
+SNAKE_API int32_t env_encode_f32(const SnakeEnv* env, int32_t crop_radius, float* out);
+
+/**
+ * @brief Gets the number of plane values per game for a crop radius.
+ * @return Values per game, or -1 if crop_radius exceeds 11584 or the
+ *         planes would not fit an int32 count
+ */
+SNAKE_API int32_t env_planes_size(const SnakeEnv* env, int32_t crop_radius);
+
+/**
+ * @brief Creates two auto-resetting batches stepped on worker threads.
+ *
+ * While the caller runs inference on one batch, the other is stepped and
+ * encoded (float planes, see env_encode_f32). Call pipeline_acquire() and
+ * pipeline_submit() alternately; the batches are handed out in turn.
+ * @param crop_radius Egocentric radius (at most 11584), or -1 for the whole board
+ * @param threads Stepping threads; 0 uses every core
+ * @return Pipeline, or NULL on invalid sizes or resource failure
+ */
+SNAKE_API SnakePipeline* pipeline_create(int32_t games_per_batch, int32_t rows, int32_t cols,
+                                         int32_t crop_radius, int32_t threads, uint64_t seed);
+SNAKE_API void pipeline_destroy(SnakePipeline* pipeline);
+
+/** @brief Waits until the next batch is stepped and describes its buffers. */
+SNAKE_API void pipeline_acquire(SnakePipeline* pipeline, SnakeBatchView* view);
+
+/**
+ * @brief Starts stepping an acquired batch with the actions written to it.
+ * @return 0, or -1 (nothing submitted) if batch_id is not a batch that is
+ *         currently acquired, e.g. one already submitted
+ */
+SNAKE_API int32_t pipeline_submit(SnakePipeline* pipeline, int32_t batch_id);
+
+SNAKE_API int32_t pipeline_obs_size(const SnakePipeline* pipeline);
+
+SNAKE_API int32_t env_num_envs(const SnakeEnv* env);
+SNAKE_API int32_t env_obs_size(const SnakeEnv* env);    /* rows * cols bytes per game */
+SNAKE_API int32_t env_score(const SnakeEnv* env, int32_t game);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SNAKEENV_H */
@@ -0,0 +1,407 @@
+// tournament.h
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "rolloutRunner.h"
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// ============================================================================
+// LATENCY HISTOGRAM
+// ============================================================================
+
+/**
+ * @brief Fixed-size log-linear histogram of nanosecond durations.
+ *
+ * Values below 8 ns get their own bucket; above that each power of two is
+ * split into 8 buckets, so a reported percentile is within 12.5% of the
+ * true value. Recording is a few bit operations and never allocates, and
+ * histograms merge by adding counts.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SubBuckets = 8;
+    static constexpr int BucketCount = 62 * SubBuckets;
+
+private:
+    uint64_t counts[BucketCount];
+    uint64_t total;
+    uint64_t maxValue;
+
+    static int bucketOf(uint64_t value) {
+        if (value < SubBuckets) return static_cast<int>(value);
+        int exponent = bit_width(value) - 1;
+        int sub = static_cast<int>(value >> (exponent - 3)) & (SubBuckets - 1);
+        return (exponent - 2) * SubBuckets + sub;
+    }
+
+    /**
+     * @brief Gets the middle of a bucket's value range.
+     */
+    static uint64_t bucketMiddle(int bucket) {
+        if (bucket < SubBuckets) return bucket;
+        int exponent = bucket / SubBuckets + 2;
+        uint64_t width = uint64_t(1) << (exponent - 3);
+        uint64_t lower = static_cast<uint64_t>(SubBuckets + bucket % SubBuckets) * width;
+        return lower + width / 2;
+    }
+
+public:
+    LatencyHistogram() { clear(); }
+
+    void clear() {
+        memset(counts, 0, sizeof(counts));
+        total = 0;
+        maxValue = 0;
+    }
+
+    void record(uint64_t nanoseconds) {
+        counts[bucketOf(nanoseconds)]++;
+        total++;
+        maxValue = max(maxValue, nanoseconds);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < BucketCount; i++) counts[i] += other.counts[i];
+        total += other.total;
+        maxValue = max(maxValue, other.maxValue);
+    }
+
+    /**
+     * @brief Gets an approximate percentile.
+     * @param fraction Quantile in [0, 1]
+     * @return Nanoseconds, or 0 if nothing was recorded
+     */
+    uint64_t percentile(double fraction) const {
+        if (total == 0) return 0;
+        uint64_t rank = max<uint64_t>(1, static_cast<uint64_t>(fraction * total + 0.5));
+        uint64_t seen = 0;
+        for (int i = 0; i < BucketCount; i++) {
+            seen += counts[i];
+            if (seen >= rank) return min(bucketMiddle(i), maxValue);
+        }
+        return maxValue;
+    }
+
+    uint64_t getCount() const { return total; }
+    uint64_t getMax() const { return maxValue; }
+};
+
+// ============================================================================
+// TOURNAMENT RUNNER
+// ============================================================================
+
+/**
+ * @brief A strategy entered in a tournament.
+ */
+struct TournamentEntry {
+    string name;
+    RolloutRunner::PolicyFactory factory;
+};
+
+/**
+ * @brief Outcome of one strategy's game on one seed.
+ */
+struct TournamentGame {
+    EpisodeResult result;
+    uint64_t decideP50;             ///< Nanoseconds per decide(), over this game
+    uint64_t decideP99;
+    uint64_t decideMax;
+    double seconds;                 ///< Wall time of the game, decisions included
+};
+
+/**
+ * @brief Everything a tournament measured for one strategy.
+ */
+struct StrategyReport {
+    string name;
+    vector<TournamentGame> games;   ///< Indexed by seed stream
+    LatencyHistogram latency;       ///< Every decide() of every game
+    long long totalTicks = 0;
+    double totalSeconds = 0;        ///< Summed per-game wall time, i.e. one core's time
+};
+
+/**
+ * @brief Plays every strategy on the same seeds, in parallel.
+ *
+ * Game i of every strategy places food from stream i of the seed, so the
+ * strategies face the same food sequence for as long as their moves agree
+ * and per-seed results can be compared pairwise. Each pool worker owns one
+ * SnakeGameLogic, restarted with setSeed() and initializeBoard() for every
+ * game, and one policy per strategy, reset() and reseeded from stream i
+ * before game i, so results do not depend on which worker ran what. (strategy, seed)
+ * jobs are interleaved across the index space so slow strategies spread
+ * over every worker. Results go into preallocated per-game slots and
+ * per-worker histograms, merged once at the end.
+ */
+class TournamentRunner {
+private:
+    struct alignas(64) WorkerContext {
+        unique_ptr<SnakeGameLogic> game;
+        vector<unique_ptr<Autopilot>> policies;
+        vector<LatencyHistogram> latency;   ///< Per strategy
+        LatencyHistogram gameLatency;
+    };
+
+    RolloutConfig config;
+    vector<TournamentEntry> entries;
+    WorkStealingPool pool;
+    vector<WorkerContext> workers;
+    double lastElapsed;
+
+    TournamentGame playGame(WorkerContext& worker, int strategy, uint32_t seedStream) {
+        using Clock = chrono::steady_clock;
+        long long maxTicks = config.maxTicksPerEpisode > 0
+            ? config.maxTicksPerEpisode
+            : 10LL * config.rows * config.cols;
+
+        SnakeGameLogic& game = *worker.game;
+        Autopilot& policy = *worker.policies[strategy];
+        LatencyHistogram& latency = worker.gameLatency;
+        Clock::time_point start = Clock::now();
+        game.setSeed(config.seed, seedStream);
+        game.initializeBoard(config.rows, config.cols, config.startingLength,
+                             config.pointsPerFood, config.initialDirection);
+        policy.reset();
+        // Seeded per game, not per worker, so results do not depend on scheduling
+        policy.reseed(Xoshiro256(~config.seed, seedStream)());
+        latency.clear();
+
+        long long ticks = 0;
+        bool alive = true;
+        while (alive && ticks < maxTicks) {
+            Clock::time_point decideStart = Clock::now();
+            Direction dir = policy.decide(game);
+            latency.record(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - decideStart).count());
+            game.setDirection(dir);
+            alive = game.update();
+            ticks++;
+        }
+        chrono::duration<double> elapsed = Clock::now() - start;
+        worker.latency[strategy].merge(latency);
+
+        EpisodeResult result = {game.getCurrentScore(), static_cast<int>(game.getSnake().getLength()), ticks,
+                                game.getGameOverReason()};
+        return {result, latency.percentile(0.5), latency.percentile(0.99), latency.getMax(),
+                elapsed.count()};
+    }
+
+public:
+    /**
+     * @brief Creates the pool, one game per worker and one policy per worker and strategy.
+     * @param config Board and episode settings; seed picks the seed set
+     * @param entries Strategies to compare
+     * @param threads Worker count including the caller; 0 uses every core
+     */
+    TournamentRunner(const RolloutConfig& config, vector<TournamentEntry> entries, int threads = 0)
+        : config(config), entries(move(entries)), pool(threads), workers(pool.getWorkerCount()),
+          lastElapsed(0) {
+        for (int i = 0; i < pool.getWorkerCount(); i++) {
+            workers[i].game = make_unique<SnakeGameLogic>(config.seed);
+            // Nothing reads snapshots, so ticks/s measures the rules and policy alone
+            workers[i].game->setPublishing(false);
+            for (const TournamentEntry& entry : this->entries) {
+                // Reseeded before every game by playGame()
+                workers[i].policies.push_back(entry.factory(Xoshiro256(~config.seed, i)()));
+            }
+            workers[i].latency.resize(this->entries.size());
+        }
+    }
+
+    /**
+     * @brief Plays every strategy on seed streams 0 to games - 1.
+     * @return One report per strategy, in entry order
+     */
+    vector<StrategyReport> run(uint32_t games) {
+        uint32_t strategyCount = static_cast<uint32_t>(entries.size());
+        vector<StrategyReport> reports(strategyCount);
+        for (uint32_t s = 0; s < strategyCount; s++) {
+            reports[s].name = entries[s].name;
+            reports[s].games.resize(games);
+        }
+        for (WorkerContext& worker : workers) {
+            for (LatencyHistogram& latency : worker.latency) latency.clear();
+        }
+
+        auto start = chrono::steady_clock::now();
+        pool.parallelFor(games * strategyCount, [&](int worker, uint32_t index) {
+            int strategy = static_cast<int>(index % strategyCount);
+            uint32_t seedStream = index / strategyCount;
+            reports[strategy].games[seedStream] = playGame(workers[worker], strategy, seedStream);
+        });
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        lastElapsed = elapsed.count();
+
+        for (uint32_t s = 0; s < strategyCount; s++) {
+            for (const WorkerContext& worker : workers) reports[s].latency.merge(worker.latency[s]);
+            for (const TournamentGame& game : reports[s].games) {
+                reports[s].totalTicks += game.result.ticks;
+                reports[s].totalSeconds += game.seconds;
+            }
+        }
+        return reports;
+    }
+
+    int getThreadCount() const { return pool.getWorkerCount(); }
+    double getLastElapsed() const { return lastElapsed; }
+    const RolloutConfig& getConfig() const { return config; }
+};
+
+// ============================================================================
+// TOURNAMENT REPORTS
+// ============================================================================
+
+/**
+ * @brief Formats tournament results as a terminal table or as CSV.
+ */
+class TournamentReport {
+private:
+    static const char* reasonName(GameOverReason reason) {
+        switch (reason) {
+            case NOT_OVER:      return "capped";
+            case OUT_OF_BOUNDS: return "out_of_bounds";
+            case HIT_WALL:      return "wall";
+            case HIT_SELF:      return "self";
+            case BOARD_FULL:    return "board_full";
+        }
+        return "unknown";
+    }
+
+    template <typename T>
+    static T percentile(vector<T> values, double fraction) {
+        if (values.empty()) return T();
+        sort(values.begin(), values.end());
+        return values[static_cast<size_t>(fraction * (values.size() - 1) + 0.5)];
+    }
+
+    static vector<int> scores(const StrategyReport& report) {
+        vector<int> values;
+        for (const TournamentGame& game : report.games) values.push_back(game.result.score);
+        return values;
+    }
+
+    static vector<long long> ticks(const StrategyReport& report) {
+        vector<long long> values;
+        for (const TournamentGame& game : report.games) values.push_back(game.result.ticks);
+        return values;
+    }
+
+    static array<long long, 5> endings(const StrategyReport& report) {
+        array<long long, 5> counts{};
+        for (const TournamentGame& game : report.games) counts[game.result.reason]++;
+        return counts;
+    }
+
+    /**
+     * @brief Formats a latency as microseconds with the unit attached, so
+     *        the table can pad value and unit as one field.
+     */
+    static string microseconds(double nanoseconds) {
+        ostringstream text;
+        text << fixed << setprecision(2) << nanoseconds / 1000.0 << "us";
+        return text.str();
+    }
+
+    static double meanScore(const StrategyReport& report) {
+        long long total = 0;
+        for (const TournamentGame& game : report.games) total += game.result.score;
+        return report.games.empty() ? 0.0 : double(total) / report.games.size();
+    }
+
+public:
+    /**
+     * @brief Writes one aligned row per strategy, best mean score first.
+     */
+    static void printTable(ostream& out, const vector<StrategyReport>& reports,
+                           const TournamentRunner& runner) {
+        vector<const StrategyReport*> ranked;
+        for (const StrategyReport& report : reports) ranked.push_back(&report);
+        stable_sort(ranked.begin(), ranked.end(), [](const StrategyReport* a, const StrategyReport* b) {
+            return meanScore(*a) > meanScore(*b);
+        });
+
+        const RolloutConfig& config = runner.getConfig();
+        long long allTicks = 0;
+        for (const StrategyReport& report : reports) allTicks += report.totalTicks;
+        out << fixed << setprecision(1);
+        out << "Tournament: " << (reports.empty() ? 0 : reports[0].games.size()) << " seeds x "
+            << reports.size() << " strategies, board " << config.rows << "x" << config.cols
+            << ", " << runner.getThreadCount() << " thread(s), " << setprecision(2)
+            << runner.getLastElapsed() << " s, " << setprecision(0)
+            << allTicks / max(runner.getLastElapsed(), 1e-9) << " ticks/s overall\n\n";
+
+        out << left << setw(10) << "strategy" << right
+            << setw(9) << "mean" << setw(8) << "p50" << setw(8) << "p90"
+            << setw(10) << "ticks p50" << setw(8) << "self" << setw(8) << "bounds"
+            << setw(8) << "full" << setw(8) << "capped"
+            << setw(12) << "dec p50" << setw(12) << "dec p99" << setw(12) << "dec max"
+            << setw(12) << "ticks/s" << "\n";
+        for (const StrategyReport* report : ranked) {
+            array<long long, 5> ended = endings(*report);
+            const LatencyHistogram& latency = report->latency;
+            out << left << setw(10) << report->name << right << setprecision(1)
+                << setw(9) << meanScore(*report)
+                << setw(8) << percentile(scores(*report), 0.5)
+                << setw(8) << percentile(scores(*report), 0.9)
+                << setw(10) << percentile(ticks(*report), 0.5)
+                << setw(8) << ended[HIT_SELF]
+                << setw(8) << ended[OUT_OF_BOUNDS] + ended[HIT_WALL]
+                << setw(8) << ended[BOARD_FULL]
+                << setw(8) << ended[NOT_OVER]
+                << " " << setw(11) << microseconds(latency.percentile(0.5))
+                << " " << setw(11) << microseconds(latency.percentile(0.99))
+                << " " << setw(11) << microseconds(latency.getMax())
+                << setprecision(0)
+                << setw(12) << report->totalTicks / max(report->totalSeconds, 1e-9) << "\n";
+        }
+        out << "\nDecision latency is per decide() call; ticks/s is per core, decisions included.\n";
+    }
+
+    /**
+     * @brief Writes one CSV row per strategy.
+     */
+    static void writeSummaryCsv(ostream& out, const vector<StrategyReport>& reports) {
+        out << "strategy,games,mean_score,p50_score,p90_score,max_score,mean_ticks,p50_ticks,"
+               "capped,out_of_bounds,wall,self,board_full,"
+               "decide_p50_ns,decide_p90_ns,decide_p99_ns,decide_max_ns,ticks_per_core_second\n";
+        for (const StrategyReport& report : reports) {
+            array<long long, 5> ended = endings(report);
+            vector<int> scoreValues = scores(report);
+            const LatencyHistogram& latency = report.latency;
+            out << report.name << ',' << report.games.size() << ','
+                << fixed << setprecision(2) << meanScore(report) << ','
+                << percentile(scoreValues, 0.5) << ',' << percentile(scoreValues, 0.9) << ','
+                << percentile(scoreValues, 1.0) << ','
+                << double(report.totalTicks) / max<size_t>(report.games.size(), 1) << ','
+                << percentile(ticks(report), 0.5) << ','
+                << ended[NOT_OVER] << ',' << ended[OUT_OF_BOUNDS] << ',' << ended[HIT_WALL] << ','
+                << ended[HIT_SELF] << ',' << ended[BOARD_FULL] << ','
+                << latency.percentile(0.5) << ',' << latency.percentile(0.9) << ','
+                << latency.percentile(0.99) << ',' << latency.getMax() << ','
+                << setprecision(0) << report.totalTicks / max(report.totalSeconds, 1e-9) << '\n';
+        }
+    }
+
+    /**
+     * @brief Writes one CSV row per strategy and seed, for pairwise comparisons.
+     */
+    static void writeGamesCsv(ostream& out, const vector<StrategyReport>& reports) {
+        out << "strategy,seed_stream,score,length,ticks,ending,decide_p50_ns,decide_p99_ns,decide_max_ns\n";
+        for (const StrategyReport& report : reports) {
+            for (size_t i = 0; i < report.games.size(); i++) {
+                const TournamentGame& game = report.games[i];
+                out << report.name << ',' << i << ',' << game.result.score << ','
+                    << game.result.length << ',' << game.result.ticks << ','
+                    << reasonName(game.result.reason) << ',' << game.decideP50 << ','
+                    << game.decideP99 << ',' << game.decideMax << '\n';
+            }
+        }
+    }
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,202 @@
+// workStealingPool.h
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// ============================================================================
+// WORK-STEALING POOL
+// ============================================================================
+
+/**
+ * @brief Persistent worker threads running index-space jobs with work stealing.
+ *
+ * parallelFor() splits [0, count) into one contiguous range per worker. A
+ * worker takes indices from the front of its own range; once it runs dry it
+ * steals the back half of another worker's range. Each range is a single
+ * 64-bit atomic (begin, end), so taking and stealing are one CAS each and no
+ * lock is held while work runs. Work is never created during a job, so a
+ * worker that finds every range empty can simply stop.
+ *
+ * The calling thread acts as worker 0, so a pool of N workers starts N - 1
+ * threads. One job runs at a time.
+ */
+class WorkStealingPool {
+public:
+    using Job = function<void(int worker, uint32_t index)>;
+
+private:
+    struct alignas(64) WorkerQueue {
+        atomic<uint64_t> range{0};  ///< begin in the high half, end in the low half
+        uint32_t victimState = 1;   ///< xorshift state for picking steal victims
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+    static uint32_t rangeBegin(uint64_t range) { return static_cast<uint32_t>(range >> 32); }
+    static uint32_t rangeEnd(uint64_t range) { return static_cast<uint32_t>(range); }
+
+    int workerCount;
+    unique_ptr<WorkerQueue[]> queues;
+    vector<thread> threads;
+
+    mutex jobMutex;
+    condition_variable jobStarted;
+    condition_variable jobFinished;
+    const Job* job = nullptr;
+    uint64_t generation = 0;
+    int busyThreads = 0;
+    bool stopping = false;
+
+    atomic<uint64_t> stealCount{0};
+
+    /**
+     * @brief Takes the next index from the front of a worker's own range.
+     */
+    bool takeOwn(int worker, uint32_t& index) {
+        atomic<uint64_t>& range = queues[worker].range;
+        uint64_t current = range.load(memory_order_acquire);
+        while (rangeBegin(current) < rangeEnd(current)) {
+            if (range.compare_exchange_weak(current, pack(rangeBegin(current) + 1, rangeEnd(current)),
+                                            memory_order_acq_rel, memory_order_acquire)) {
+                index = rangeBegin(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Moves the back half of some other worker's range into this one.
+     * @return False once every other range is empty
+     */
+    bool steal(int worker) {
+        uint32_t& state = queues[worker].victimState;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        int start = static_cast<int>(state % workerCount);
+
+        for (int k = 0; k < workerCount; k++) {
+            int victim = (start + k) % workerCount;
+            if (victim == worker) continue;
+
+            atomic<uint64_t>& range = queues[victim].range;
+            uint64_t current = range.load(memory_order_acquire);
+            while (rangeBegin(current) < rangeEnd(current)) {
+                uint32_t size = rangeEnd(current) - rangeBegin(current);
+                uint32_t split = rangeEnd(current) - (size + 1) / 2;
+                if (range.compare_exchange_weak(current, pack(rangeBegin(current), split),
+                                                memory_order_acq_rel, memory_order_acquire)) {
+                    // Our own range is empty, so nobody else can change it now
+                    queues[worker].range.store(pack(split, rangeEnd(current)), memory_order_release);
+                    stealCount.fetch_add(1, memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void runWorker(int worker) {
+        uint32_t index;
+        do {
+            while (takeOwn(worker, index)) {
+                (*job)(worker, index);
+            }
+        } while (steal(worker));
+    }
+
+    void threadMain(int worker) {
+        uint64_t seenGeneration = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(jobMutex);
+                jobStarted.wait(lock, [&] { return stopping || generation != seenGeneration; });
+                if (stopping) return;
+                seenGeneration = generation;
+            }
+            runWorker(worker);
+            {
+                lock_guard<mutex> lock(jobMutex);
+                if (--busyThreads == 0) jobFinished.notify_one();
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param workers Number of workers including the caller; 0 uses every core
+     */
+    explicit WorkStealingPool(int workers = 0)
+        : workerCount(workers > 0 ? workers : max(1, static_cast<int>(thread::hardware_concurrency()))),
+          queues(new WorkerQueue[workerCount]) {
+        for (int i = 0; i < workerCount; i++) {
+            queues[i].victimState = 2463534242u + 7919u * static_cast<uint32_t>(i);
+        }
+        for (int i = 1; i < workerCount; i++) {
+            threads.emplace_back(&WorkStealingPool::threadMain, this, i);
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobStarted.notify_all();
+        for (thread& t : threads) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Runs body(worker, i) for every i in [0, count) and waits for all.
+     *
+     * Each worker index is used by exactly one thread at a time, so bodies
+     * can keep per-worker state in an array indexed by worker without locks.
+     * @param count Number of indices
+     * @param body Work item; must not call parallelFor() on the same pool
+     */
+    void parallelFor(uint32_t count, const Job& body) {
+        for (int i = 0; i < workerCount; i++) {
+            uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(count) * i / workerCount);
+            uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(count) * (i + 1) / workerCount);
+            queues[i].range.store(pack(begin, end), memory_order_relaxed);
+        }
+        {
+            lock_guard<mutex> lock(jobMutex);
+            job = &body;
+            busyThreads = workerCount - 1;
+            generation++;
+        }
+        jobStarted.notify_all();
+
+        runWorker(0);
+
+        unique_lock<mutex> lock(jobMutex);
+        jobFinished.wait(lock, [&] { return busyThreads == 0; });
+        job = nullptr;
+    }
+
+    int getWorkerCount() const { return workerCount; }
+
+    /**
+     * @brief Gets how many successful steals happened since construction.
+     */
+    uint64_t getStealCount() const { return stealCount.load(memory_order_relaxed); }
+};
+
+#endif // WORKSTEALINGPOOL_H